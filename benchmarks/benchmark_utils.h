@@ -0,0 +1,31 @@
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Helpers shared by the benchmarks
+namespace DrowsinessDetector
+{
+    inline bool isVideoFile(const std::filesystem::path &path)
+    {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        return ext == ".mp4" || ext == ".avi" || ext == ".mov" || ext == ".mkv";
+    }
+
+    // Nearest-rank percentile, p in [0, 100]; 0 for no values
+    inline double percentile(std::vector<double> values, double p)
+    {
+        if (values.empty())
+            return 0.0;
+        std::sort(values.begin(), values.end());
+        const size_t index = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+        return values[std::min(index, values.size() - 1)];
+    }
+}
+
+#endif // BENCHMARK_UTILS_H
@@ -0,0 +1,153 @@
+// Detection time vs. recall for Config::detection_scale.
+//
+// Every sampled frame of every video in the directory is scanned once at full
+// resolution (the reference) and once per scale. A scaled detection counts as a
+// hit when it overlaps the reference face with IoU >= 0.5; recall is measured
+// over the frames where the reference found a face.
+//
+// Usage: detection_scale_benchmark [videos_dir] [model_path] [sample_stride] [max_frames_per_video]
+
+#include "../include/facial_landmark_detector.h"
+#include "../include/config.h"
+#include "benchmark_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace DrowsinessDetector;
+
+namespace
+{
+    struct ScaleResult
+    {
+        double scale = 1.0;
+        double total_ms = 0.0;
+        size_t frames = 0;
+        size_t hits = 0;
+    };
+
+    const dlib::rectangle *largestFace(const std::vector<dlib::rectangle> &faces)
+    {
+        if (faces.empty())
+            return nullptr;
+        return &*std::max_element(faces.begin(), faces.end(),
+                                  [](const dlib::rectangle &a, const dlib::rectangle &b)
+                                  {
+                                      return a.area() < b.area();
+                                  });
+    }
+
+    double intersectionOverUnion(const dlib::rectangle &a, const dlib::rectangle &b)
+    {
+        const double inter = static_cast<double>(a.intersect(b).area());
+        const double uni = static_cast<double>(a.area() + b.area()) - inter;
+        return uni > 0.0 ? inter / uni : 0.0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string videos_dir = argc > 1 ? argv[1] : "Videos";
+    const std::string model_path = argc > 2 ? argv[2] : Config().model_path;
+    const int sample_stride = argc > 3 ? std::max(1, std::stoi(argv[3])) : 5;
+    const int max_frames = argc > 4 ? std::stoi(argv[4]) : 200;
+
+    Config model_config;
+    model_config.model_path = model_path;
+    auto predictor = LandmarkPredictor::load(model_config);
+    if (!predictor)
+        return -1;
+
+    const std::vector<double> scales = {1.0, 0.75, 0.5, 0.33, 0.25};
+    std::vector<ScaleResult> results;
+    std::vector<std::unique_ptr<FacialLandmarkDetector>> detectors;
+    for (double scale : scales)
+    {
+        Config config;
+        config.detection_scale = scale;
+        detectors.push_back(std::make_unique<FacialLandmarkDetector>(config));
+        if (!detectors.back()->initialize(predictor))
+            return -1;
+        ScaleResult result;
+        result.scale = scale;
+        results.push_back(result);
+    }
+
+    std::vector<std::filesystem::path> videos;
+    for (const auto &entry : std::filesystem::directory_iterator(videos_dir))
+    {
+        if (entry.is_regular_file() && isVideoFile(entry.path()))
+            videos.push_back(entry.path());
+    }
+    std::sort(videos.begin(), videos.end());
+    if (videos.empty())
+    {
+        std::cerr << "No videos found in " << videos_dir << std::endl;
+        return -1;
+    }
+
+    size_t reference_faces = 0;
+    for (const auto &video : videos)
+    {
+        cv::VideoCapture cap(video.string());
+        if (!cap.isOpened())
+        {
+            std::cerr << "Skipping unreadable video: " << video << std::endl;
+            continue;
+        }
+
+        std::cout << "Benchmarking " << video.filename().string() << "..." << std::endl;
+        cv::Mat frame;
+        long long frame_index = 0;
+        int sampled = 0;
+        while (sampled < max_frames && cap.read(frame))
+        {
+            if (frame_index++ % sample_stride != 0)
+                continue;
+            sampled++;
+
+            // Scale 1.0 doubles as the reference
+            std::vector<dlib::rectangle> reference;
+            for (size_t i = 0; i < scales.size(); ++i)
+            {
+                auto start = std::chrono::steady_clock::now();
+                std::vector<dlib::rectangle> faces = detectors[i]->detectFaces(frame);
+                auto end = std::chrono::steady_clock::now();
+
+                results[i].total_ms += std::chrono::duration<double, std::milli>(end - start).count();
+                results[i].frames++;
+                if (i == 0)
+                {
+                    reference = faces;
+                    if (!reference.empty())
+                        reference_faces++;
+                }
+
+                const dlib::rectangle *expected = largestFace(reference);
+                const dlib::rectangle *found = largestFace(faces);
+                if (expected && found && intersectionOverUnion(*expected, *found) >= 0.5)
+                    results[i].hits++;
+            }
+        }
+    }
+
+    std::cout << "\nFrames with a reference face: " << reference_faces << "\n\n";
+    std::cout << std::left << std::setw(8) << "Scale" << std::setw(16) << "Mean ms/frame"
+              << std::setw(10) << "Speedup" << "Recall" << std::endl;
+    const double baseline_ms = results[0].frames ? results[0].total_ms / results[0].frames : 0.0;
+    for (const auto &result : results)
+    {
+        const double mean_ms = result.frames ? result.total_ms / result.frames : 0.0;
+        const double recall = reference_faces ? static_cast<double>(result.hits) / reference_faces : 0.0;
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(8) << result.scale
+                  << std::setw(16) << mean_ms
+                  << std::setw(10) << (mean_ms > 0.0 ? baseline_ms / mean_ms : 0.0)
+                  << recall * 100.0 << "%" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,237 @@
+// Per-frame latency percentiles, detection rate and landmark agreement with HOG
+// of every face detector backend.
+//
+// Sampled frames of every video in the directory are run through each backend
+// that can be created (missing model files or an old OpenCV skip a backend).
+// Detection rate is the share of frames with at least one face. On frames where
+// both HOG and a backend find a face, the shape predictor runs in both boxes and
+// the benchmark reports how far the landmarks (in inter-ocular distances) and
+// the EAR move. It also prints the FaceBoxCalibration that would map the
+// backend's raw boxes onto HOG's: the current calibration composed with the
+// offset/scale still left between the calibrated box and HOG, ready to paste
+// into Config to tune a backend for a camera.
+//
+// Usage: face_detector_benchmark [videos_dir] [sample_stride] [max_frames_per_video]
+
+#include "../include/face_detector.h"
+#include "../include/face_ratio_kernel.h"
+#include "../include/landmark_predictor.h"
+#include "../include/config.h"
+#include "benchmark_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace DrowsinessDetector;
+
+namespace
+{
+    struct BackendResult
+    {
+        FaceDetectorBackend backend;
+        std::unique_ptr<FaceDetector> detector;
+        std::vector<double> latencies_ms;
+        size_t frames_with_face = 0;
+
+        // Agreement with HOG on frames where both found a face
+        size_t compared = 0;
+        double landmark_error = 0.0; // Mean point distance / inter-ocular distance
+        double ear_error = 0.0;      // |EAR - EAR with the HOG box|
+        double offset_x = 0.0, offset_y = 0.0, scale_x = 0.0, scale_y = 0.0; // Calibrated box vs. HOG
+    };
+
+    FaceBoxCalibration currentCalibration(FaceDetectorBackend backend, const Config &config)
+    {
+        switch (backend)
+        {
+        case FaceDetectorBackend::HAAR:
+            return config.haar_box_calibration;
+        case FaceDetectorBackend::YUNET:
+            return config.yunet_box_calibration;
+        default:
+            return FaceBoxCalibration();
+        }
+    }
+
+    // The residual is measured on the calibrated box, whose size is the raw size times the
+    // current scale; composing it gives offsets in raw-box units again, as toHogGeometry expects
+    FaceBoxCalibration composeCalibration(const FaceBoxCalibration &current, const BackendResult &result)
+    {
+        const double n = static_cast<double>(result.compared);
+        FaceBoxCalibration composed;
+        composed.offset_x = current.offset_x + result.offset_x / n * current.scale_x;
+        composed.offset_y = current.offset_y + result.offset_y / n * current.scale_y;
+        composed.scale_x = current.scale_x * result.scale_x / n;
+        composed.scale_y = current.scale_y * result.scale_y / n;
+        return composed;
+    }
+
+    const dlib::rectangle &largest(const std::vector<dlib::rectangle> &faces)
+    {
+        return *std::max_element(faces.begin(), faces.end(),
+                                 [](const dlib::rectangle &a, const dlib::rectangle &b)
+                                 {
+                                     return a.area() < b.area();
+                                 });
+    }
+
+    void compareWithHog(BackendResult &result, const LandmarkPredictor &predictor, const cv::Mat &frame,
+                        const dlib::rectangle &hog_box, const FaceLandmarks &hog_landmarks, const dlib::rectangle &box)
+    {
+        FaceLandmarks landmarks;
+        predictor.predict(frame, box, landmarks);
+        if (!landmarks.isComplete())
+            return;
+
+        // Outer eye corners
+        const int right_corner = LandmarkLayout::RIGHT_EYE.horizontal.from;
+        const int left_corner = LandmarkLayout::LEFT_EYE.horizontal.to;
+        const double interocular = std::hypot(hog_landmarks.x[left_corner] - hog_landmarks.x[right_corner],
+                                              hog_landmarks.y[left_corner] - hog_landmarks.y[right_corner]);
+        if (interocular <= 0.0)
+            return;
+
+        double distance = 0.0;
+        for (int i = 0; i < FaceLandmarks::MAX_POINTS; ++i)
+            distance += std::hypot(landmarks.x[i] - hog_landmarks.x[i], landmarks.y[i] - hog_landmarks.y[i]);
+
+        result.compared++;
+        result.landmark_error += distance / FaceLandmarks::MAX_POINTS / interocular;
+        result.ear_error += std::abs(FaceRatioKernel::compute(landmarks).ear() - FaceRatioKernel::compute(hog_landmarks).ear());
+        result.offset_x += (dlib::center(hog_box).x() - dlib::center(box).x()) / static_cast<double>(box.width());
+        result.offset_y += (dlib::center(hog_box).y() - dlib::center(box).y()) / static_cast<double>(box.height());
+        result.scale_x += static_cast<double>(hog_box.width()) / box.width();
+        result.scale_y += static_cast<double>(hog_box.height()) / box.height();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string videos_dir = argc > 1 ? argv[1] : "Videos";
+    const int sample_stride = argc > 2 ? std::max(1, std::stoi(argv[2])) : 5;
+    const int max_frames = argc > 3 ? std::stoi(argv[3]) : 200;
+
+    Config config;
+    std::vector<BackendResult> results;
+    for (FaceDetectorBackend backend : {FaceDetectorBackend::HOG, FaceDetectorBackend::HAAR, FaceDetectorBackend::YUNET})
+    {
+        BackendResult result;
+        result.backend = backend;
+        result.detector = FaceDetector::create(backend, config);
+        if (result.detector)
+            results.push_back(std::move(result));
+    }
+    if (results.empty())
+        return -1;
+
+    // Agreement needs HOG as the reference and a landmark model; without either only speed is reported
+    std::shared_ptr<const LandmarkPredictor> predictor = LandmarkPredictor::load(config);
+    const bool compare = predictor && results.front().detector->getName() == "hog";
+
+    std::vector<std::filesystem::path> videos;
+    for (const auto &entry : std::filesystem::directory_iterator(videos_dir))
+    {
+        if (entry.is_regular_file() && isVideoFile(entry.path()))
+            videos.push_back(entry.path());
+    }
+    std::sort(videos.begin(), videos.end());
+    if (videos.empty())
+    {
+        std::cerr << "No videos found in " << videos_dir << std::endl;
+        return -1;
+    }
+
+    for (const auto &video : videos)
+    {
+        cv::VideoCapture cap(video.string());
+        if (!cap.isOpened())
+        {
+            std::cerr << "Skipping unreadable video: " << video << std::endl;
+            continue;
+        }
+
+        std::cout << "Benchmarking " << video.filename().string() << "..." << std::endl;
+        cv::Mat frame;
+        long long frame_index = 0;
+        int sampled = 0;
+        while (sampled < max_frames && cap.read(frame))
+        {
+            if (frame_index++ % sample_stride != 0)
+                continue;
+            sampled++;
+
+            bool have_hog_face = false;
+            dlib::rectangle hog_box;
+            FaceLandmarks hog_landmarks;
+            for (auto &result : results)
+            {
+                auto start = std::chrono::steady_clock::now();
+                std::vector<dlib::rectangle> faces = result.detector->detect(frame);
+                auto end = std::chrono::steady_clock::now();
+
+                result.latencies_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                if (faces.empty())
+                    continue;
+                result.frames_with_face++;
+                if (!compare)
+                    continue;
+
+                // HOG runs first and sets the reference for the other backends
+                if (&result == &results.front())
+                {
+                    hog_box = largest(faces);
+                    predictor->predict(frame, hog_box, hog_landmarks);
+                    have_hog_face = hog_landmarks.isComplete();
+                }
+                else if (have_hog_face)
+                {
+                    compareWithHog(result, *predictor, frame, hog_box, hog_landmarks, largest(faces));
+                }
+            }
+        }
+    }
+
+    std::cout << "\n" << std::left << std::setw(8) << "Backend" << std::setw(8) << "Frames"
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p90 ms" << std::setw(10) << "p99 ms"
+              << std::setw(10) << "max ms" << "Detection rate" << std::endl;
+    for (const auto &result : results)
+    {
+        const size_t frames = result.latencies_ms.size();
+        const double rate = frames ? static_cast<double>(result.frames_with_face) / frames : 0.0;
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(8) << result.detector->getName()
+                  << std::setw(8) << frames
+                  << std::setw(10) << percentile(result.latencies_ms, 50.0)
+                  << std::setw(10) << percentile(result.latencies_ms, 90.0)
+                  << std::setw(10) << percentile(result.latencies_ms, 99.0)
+                  << std::setw(10) << percentile(result.latencies_ms, 100.0)
+                  << rate * 100.0 << "%" << std::endl;
+    }
+
+    if (!compare)
+        return 0;
+
+    std::cout << "\nAgreement with HOG (same frames, same shape predictor)\n"
+              << std::left << std::setw(8) << "Backend" << std::setw(10) << "Frames" << std::setw(14) << "Landmark err"
+              << std::setw(10) << "EAR err" << "Calibration to match HOG {offset_x, offset_y, scale_x, scale_y}" << std::endl;
+    for (const auto &result : results)
+    {
+        if (&result == &results.front() || result.compared == 0)
+            continue;
+        const double n = static_cast<double>(result.compared);
+        const FaceBoxCalibration calibration = composeCalibration(currentCalibration(result.backend, config), result);
+        std::cout << std::left << std::fixed << std::setprecision(3)
+                  << std::setw(8) << result.detector->getName()
+                  << std::setw(10) << result.compared
+                  << std::setw(14) << result.landmark_error / n
+                  << std::setw(10) << result.ear_error / n
+                  << "{" << calibration.offset_x << ", " << calibration.offset_y << ", "
+                  << calibration.scale_x << ", " << calibration.scale_y << "}" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+// EAR/MAR: FaceRatioKernel vs. the scalar CVUtils::aspectRatio reference.
+//
+// Synthesizes landmark sets (face-sized point grids with random jitter), then
+// times three ways of computing both EARs and the MAR for every set:
+//   scalar  - CVUtils::aspectRatio per eye and for the mouth, in double
+//   fused   - FaceRatioKernel::compute per frame
+//   batch   - FaceRatioKernel::computeBatch over the whole array
+// and reports ns/frame plus the largest deviation from the scalar results.
+//
+// Usage: face_ratio_benchmark [frames] [repetitions]
+
+#include "../include/face_ratio_kernel.h"
+#include "../include/cv_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace DrowsinessDetector;
+
+namespace
+{
+    std::vector<FaceLandmarks> makeLandmarks(size_t count)
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> jitter(-4.0f, 4.0f);
+        std::uniform_real_distribution<float> offset(50.0f, 400.0f);
+
+        std::vector<FaceLandmarks> sets(count);
+        for (auto &set : sets)
+        {
+            // Face-sized scatter around a random position; rounded like detector output
+            const float ox = offset(rng), oy = offset(rng);
+            for (int i = 0; i < FaceLandmarks::MAX_POINTS; ++i)
+            {
+                set.x[i] = std::round(ox + 3.0f * (i % 17) + jitter(rng));
+                set.y[i] = std::round(oy + 4.0f * (i / 17) + jitter(rng));
+            }
+            set.count = FaceLandmarks::MAX_POINTS;
+        }
+        return sets;
+    }
+
+    FaceRatios scalarRatios(const FaceLandmarks &landmarks)
+    {
+        FaceRatios ratios;
+        ratios.left_ear = CVUtils::aspectRatio<LandmarkLayout::LEFT_EYE>(landmarks);
+        ratios.right_ear = CVUtils::aspectRatio<LandmarkLayout::RIGHT_EYE>(landmarks);
+        ratios.mar = CVUtils::aspectRatio<LandmarkLayout::MOUTH>(landmarks);
+        return ratios;
+    }
+
+    double maxDeviation(const std::vector<FaceRatios> &expected, const std::vector<FaceRatios> &actual)
+    {
+        double deviation = 0.0;
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            deviation = std::max(deviation, std::abs(expected[i].left_ear - actual[i].left_ear));
+            deviation = std::max(deviation, std::abs(expected[i].right_ear - actual[i].right_ear));
+            deviation = std::max(deviation, std::abs(expected[i].mar - actual[i].mar));
+        }
+        return deviation;
+    }
+
+    template <typename Fn>
+    double timeNsPerFrame(Fn fn, size_t frames, int repetitions)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repetitions; ++r)
+            fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(frames) * repetitions);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t frames = argc > 1 ? static_cast<size_t>(std::max(1, std::stoi(argv[1]))) : 10000;
+    const int repetitions = argc > 2 ? std::max(1, std::stoi(argv[2])) : 50;
+
+    const std::vector<FaceLandmarks> landmarks = makeLandmarks(frames);
+    std::vector<FaceRatios> scalar(frames), fused(frames), batch(frames);
+
+    auto run_scalar = [&]()
+    {
+        for (size_t i = 0; i < frames; ++i)
+            scalar[i] = scalarRatios(landmarks[i]);
+    };
+    auto run_fused = [&]()
+    {
+        for (size_t i = 0; i < frames; ++i)
+            fused[i] = FaceRatioKernel::compute(landmarks[i]);
+    };
+    auto run_batch = [&]()
+    {
+        FaceRatioKernel::computeBatch(landmarks.data(), frames, batch.data());
+    };
+
+    // Warm up and fill the result arrays
+    run_scalar();
+    run_fused();
+    run_batch();
+
+    const double scalar_ns = timeNsPerFrame(run_scalar, frames, repetitions);
+    const double fused_ns = timeNsPerFrame(run_fused, frames, repetitions);
+    const double batch_ns = timeNsPerFrame(run_batch, frames, repetitions);
+
+    std::cout << "Frames: " << frames << " | Repetitions: " << repetitions
+              << " | Kernel: " << FaceRatioKernel::getInstructionSet() << "\n"
+              << std::fixed << std::setprecision(1)
+              << "scalar: " << scalar_ns << " ns/frame\n"
+              << "fused:  " << fused_ns << " ns/frame (" << std::setprecision(2) << scalar_ns / fused_ns << "x)\n"
+              << std::setprecision(1)
+              << "batch:  " << batch_ns << " ns/frame (" << std::setprecision(2) << scalar_ns / batch_ns << "x)\n"
+              << std::scientific << std::setprecision(2)
+              << "Max deviation from scalar: fused " << maxDeviation(scalar, fused)
+              << ", batch " << maxDeviation(scalar, batch) << std::endl;
+    return 0;
+}
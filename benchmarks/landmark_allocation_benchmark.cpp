@@ -0,0 +1,124 @@
+// Heap allocations per frame in FrameAnalyzer::analyze.
+//
+// Replaces global operator new with a counting version and runs one
+// FrameAnalyzer over a video in event time, with the flat landmark engine, face
+// tracking, PERCLOS and blink detection on, so most frames take the tracked
+// path (no face detector) and every per-frame stage runs: landmarks, EAR/MAR,
+// StateTracker and the FrameResult. After a warm-up the allocations made by
+// analyze() are counted separately for tracked and detected frames. Exits
+// non-zero if a tracked frame allocated.
+//
+// Head pose follows Config::enable_head_pose_detection (off by default);
+// cv::solvePnP allocates its temporaries, so with it on the check fails.
+//
+// Usage: landmark_allocation_benchmark [video_path] [model_path] [warmup_frames] [max_frames]
+
+#include "../include/frame_analyzer.h"
+#include "../include/config.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace
+{
+    std::atomic<size_t> allocation_count{0};
+
+    struct FrameCount
+    {
+        size_t frames = 0;
+        size_t allocations = 0;
+    };
+
+    void printCount(const char *name, const FrameCount &count)
+    {
+        const double frames = static_cast<double>(std::max<size_t>(1, count.frames));
+        std::cout << name << " frames: " << count.frames
+                  << " | allocations/frame in analyze(): " << count.allocations / frames << "\n";
+    }
+}
+
+void *operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace DrowsinessDetector;
+
+int main(int argc, char *argv[])
+{
+    Config config;
+    const std::string video_path = argc > 1 ? argv[1] : config.video_path;
+    if (argc > 2)
+        config.model_path = argv[2];
+    const int warmup_frames = argc > 3 ? std::max(0, std::stoi(argv[3])) : 30;
+    const int max_frames = argc > 4 ? std::stoi(argv[4]) : 1000;
+
+    // The configuration the zero-allocation steady state is stated for (see Config)
+    config.use_flat_shape_predictor = true;
+    config.enable_face_tracking = true;
+    config.enable_perclos = true;
+    config.enable_blink_detection = true;
+
+    FrameAnalyzer analyzer(config);
+    if (!analyzer.initialize(LandmarkPredictor::load(config)))
+        return -1;
+    analyzer.setUseEventTime(true);
+
+    cv::VideoCapture cap(video_path);
+    if (!cap.isOpened())
+    {
+        std::cerr << "Cannot open " << video_path << std::endl;
+        return -1;
+    }
+
+    FrameCount tracked_count, detected_count;
+    cv::Mat frame;
+    double checksum = 0.0;
+    for (int index = 0; index < max_frames && cap.read(frame); ++index)
+    {
+        const double timestamp_ms = cap.get(cv::CAP_PROP_POS_MSEC);
+        size_t tracked_before = 0, detected_before = 0, tracked_after = 0, detected_after = 0;
+        analyzer.getLandmarkDetector().getTrackingStats(tracked_before, detected_before);
+
+        const size_t start = allocation_count.load();
+        const FrameResult result = analyzer.analyze(frame, timestamp_ms);
+        const size_t allocations = allocation_count.load() - start;
+
+        if (!result.face_detected || index < warmup_frames)
+            continue;
+        checksum += result.ear + result.mar;
+
+        analyzer.getLandmarkDetector().getTrackingStats(tracked_after, detected_after);
+        FrameCount &count = tracked_after > tracked_before ? tracked_count : detected_count;
+        count.frames++;
+        count.allocations += allocations;
+    }
+
+    std::cout << "Landmark engine: flat | Head pose: " << (analyzer.isHeadPoseActive() ? "on" : "off")
+              << " | Warm-up frames: " << warmup_frames << "\n";
+    printCount("Tracked ", tracked_count);
+    printCount("Detected", detected_count);
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+
+    const bool steady_state_clean = tracked_count.allocations == 0;
+    std::cout << (steady_state_clean ? "Steady state: zero allocations per tracked frame"
+                                     : "Steady state: tracked frames allocate")
+              << std::endl;
+    return steady_state_clean ? 0 : 1;
+}
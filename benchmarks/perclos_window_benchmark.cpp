@@ -0,0 +1,55 @@
+// PerclosWindow at, below and above its nominal frame rate.
+//
+// Feeds one window, sized for the nominal rate, with frames at half to eight
+// times that rate and a fixed closed-eye duty cycle, then reports the covered time,
+// whether the window counts as full, the PERCLOS value against the duty cycle
+// and the cost per add(). Faster sources must merge into buckets rather than
+// shorten the window; the exit code is non-zero if any rate leaves the window
+// short or the ratio off.
+//
+// Usage: perclos_window_benchmark [window_seconds] [nominal_fps]
+
+#include "../include/perclos_window.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace DrowsinessDetector;
+
+int main(int argc, char *argv[])
+{
+    const double window_seconds = argc > 1 ? std::max(1.0, std::stod(argv[1])) : 60.0;
+    const double nominal_fps = argc > 2 ? std::max(1.0, std::stod(argv[2])) : 30.0;
+    const double closed_share = 0.3; // 3 of every 10 frames closed
+
+    bool ok = true;
+    std::cout << "Window: " << window_seconds << " s | Nominal: " << nominal_fps << " fps\n";
+    for (double factor : {0.5, 1.0, 2.0, 4.0, 8.0})
+    {
+        const double fps = nominal_fps * factor;
+        const long long frames = static_cast<long long>(std::ceil(2.0 * window_seconds * fps));
+        PerclosWindow window(window_seconds, nominal_fps);
+
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < frames; ++i)
+            window.add(1.0 / fps, (i % 10) < 3);
+        auto end = std::chrono::steady_clock::now();
+
+        const bool full = window.isFull();
+        const double error = std::abs(window.getPerclos() - closed_share);
+        const bool rate_ok = full && window.getCoveredSeconds() < window_seconds + 1.0 && error < 0.01;
+        ok = ok && rate_ok;
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(6) << fps << " fps: covered " << std::setprecision(3) << window.getCoveredSeconds() << " s"
+                  << " | full " << (full ? "yes" : "no")
+                  << " | PERCLOS " << window.getPerclos()
+                  << " | " << std::setprecision(1)
+                  << std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(frames) << " ns/add"
+                  << (rate_ok ? "" : "  <-- FAIL") << "\n";
+    }
+    return ok ? 0 : 1;
+}
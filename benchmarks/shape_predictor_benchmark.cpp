@@ -0,0 +1,125 @@
+// Landmark inference: FlatShapePredictor vs. dlib::shape_predictor.
+//
+// Faces are found once per sampled frame with the HOG detector; both engines
+// then run on the same frame and box. Reports mean time per call, the speedup
+// and how many landmarks differ between the two engines.
+//
+// Usage: shape_predictor_benchmark [videos_dir] [model_path] [sample_stride] [max_frames_per_video] [repetitions]
+
+#include "../include/dlib_landmark_predictor.h"
+#include "../include/flat_shape_predictor.h"
+#include "../include/face_detector.h"
+#include "../include/config.h"
+#include "benchmark_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace DrowsinessDetector;
+
+namespace
+{
+    struct Sample
+    {
+        cv::Mat frame;
+        dlib::rectangle face;
+    };
+
+    double timePredictor(const LandmarkPredictor &predictor, const std::vector<Sample> &samples, int repetitions)
+    {
+        FaceLandmarks landmarks;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repetitions; ++r)
+        {
+            for (const auto &sample : samples)
+                predictor.predict(sample.frame, sample.face, landmarks);
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / (repetitions * samples.size());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string videos_dir = argc > 1 ? argv[1] : "Videos";
+    const std::string model_path = argc > 2 ? argv[2] : Config().model_path;
+    const int sample_stride = argc > 3 ? std::max(1, std::stoi(argv[3])) : 10;
+    const int max_frames = argc > 4 ? std::stoi(argv[4]) : 50;
+    const int repetitions = argc > 5 ? std::max(1, std::stoi(argv[5])) : 20;
+
+    DlibLandmarkPredictor dlib_predictor;
+    if (!dlib_predictor.load(model_path))
+        return -1;
+    auto flat_predictor = FlatShapePredictor::loadDat(model_path);
+    if (!flat_predictor)
+        return -1;
+
+    // Collect frames with a detected face
+    Config config;
+    auto face_detector = FaceDetector::create(FaceDetectorBackend::HOG, config);
+    std::vector<Sample> samples;
+    for (const auto &entry : std::filesystem::directory_iterator(videos_dir))
+    {
+        if (!entry.is_regular_file() || !isVideoFile(entry.path()))
+            continue;
+
+        cv::VideoCapture cap(entry.path().string());
+        cv::Mat frame;
+        long long frame_index = 0;
+        int sampled = 0;
+        while (sampled < max_frames && cap.read(frame))
+        {
+            if (frame_index++ % sample_stride != 0)
+                continue;
+            std::vector<dlib::rectangle> faces = face_detector->detect(frame);
+            if (faces.empty())
+                continue;
+            sampled++;
+            samples.push_back({frame.clone(), faces.front()});
+        }
+    }
+    if (samples.empty())
+    {
+        std::cerr << "No faces found in " << videos_dir << std::endl;
+        return -1;
+    }
+
+    // Agreement between the engines
+    size_t parts_total = 0, parts_different = 0;
+    long max_deviation = 0;
+    FaceLandmarks expected, actual;
+    for (const auto &sample : samples)
+    {
+        dlib_predictor.predict(sample.frame, sample.face, expected);
+        flat_predictor->predict(sample.frame, sample.face, actual);
+        for (int i = 0; i < expected.count; ++i)
+        {
+            const long deviation = static_cast<long>(std::max(std::fabs(expected.x[i] - actual.x[i]),
+                                                              std::fabs(expected.y[i] - actual.y[i])));
+            parts_total++;
+            if (deviation != 0)
+                parts_different++;
+            max_deviation = std::max(max_deviation, deviation);
+        }
+    }
+
+    // Warm both engines up once before timing
+    timePredictor(dlib_predictor, samples, 1);
+    timePredictor(*flat_predictor, samples, 1);
+    const double dlib_us = timePredictor(dlib_predictor, samples, repetitions);
+    const double flat_us = timePredictor(*flat_predictor, samples, repetitions);
+
+    std::cout << "Faces: " << samples.size() << " | Repetitions: " << repetitions << "\n"
+              << std::fixed << std::setprecision(1)
+              << "dlib: " << dlib_us << " us/face\n"
+              << "flat: " << flat_us << " us/face (" << std::setprecision(2) << dlib_us / flat_us << "x)\n"
+              << "Landmarks differing: " << parts_different << "/" << parts_total
+              << " | Max deviation: " << max_deviation << " px" << std::endl;
+    return parts_different == 0 ? 0 : 1;
+}
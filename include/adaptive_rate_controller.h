@@ -0,0 +1,42 @@
+#ifndef ADAPTIVE_RATE_CONTROLLER_H
+#define ADAPTIVE_RATE_CONTROLLER_H
+
+#include <atomic>
+#include "config.h"
+#include "frame_pipeline.h"
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief Chooses the processing stride (process every N-th frame) from the driver's state
+     *
+     * While EAR/MAR are far from their thresholds, the head faces forward and no
+     * StateTracker timer runs, the stride grows until inference fits the CPU budget.
+     * As soon as EAR nears the threshold, a timer starts, the head turns or the face
+     * is lost, the stride drops back to 1 (full rate) on the very next frame.
+     * update() and getStride() may be called from different threads.
+     */
+    class AdaptiveRateController
+    {
+    private:
+        Config config_;
+        std::atomic<int> stride_{1};
+        double avg_processing_ms_ = 0.0; // Exponential moving average of inference cost
+        double frame_interval_ms_ = 1000.0 / 30.0;
+        int relaxed_streak_ = 0;
+
+        bool isClearlyAlert(const FrameResult &result) const;
+
+    public:
+        explicit AdaptiveRateController(const Config &config);
+
+        void setSourceFps(double fps);
+
+        // Feed the outcome and inference cost of every processed frame
+        void update(const FrameResult &result, double processing_ms);
+
+        int getStride() const { return stride_; }
+    };
+}
+
+#endif // ADAPTIVE_RATE_CONTROLLER_H
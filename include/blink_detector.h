@@ -0,0 +1,97 @@
+#ifndef BLINK_DETECTOR_H
+#define BLINK_DETECTOR_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "config.h"
+
+namespace DrowsinessDetector
+{
+    struct BlinkEvent
+    {
+        std::chrono::steady_clock::time_point end;
+        double duration_seconds = 0.0;
+    };
+
+    // Blinks over the last Config::blink_window_seconds
+    struct BlinkStats
+    {
+        size_t total_blinks = 0;      // Since start, not windowed
+        size_t window_blinks = 0;
+        double rate_per_minute = 0.0;
+        double mean_duration = 0.0;   // Seconds
+        double p95_duration = 0.0;    // Seconds, to histogram bin resolution
+    };
+
+    /**
+     * @brief Streaming blink segmentation on the per-frame EAR
+     *
+     * A blink starts when EAR drops below ear_threshold and ends when it rises
+     * above ear_threshold + blink_hysteresis, so noise around the threshold does
+     * not split one blink into several. Closures shorter than blink_min_seconds
+     * (landmark jitter) or longer than blink_max_seconds (eye closure, covered by
+     * the drowsiness timers) are not counted.
+     *
+     * Blinks in the window sit in a fixed ring buffer and their durations in a
+     * fixed histogram, so memory is constant, an update is O(1) amortized and
+     * p95 is a walk over the histogram bins.
+     */
+    class BlinkDetector
+    {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t MAX_WINDOW_BLINKS = 256; // Oldest blinks drop beyond this (> 4 blinks/s over 60 s)
+        static constexpr size_t HISTOGRAM_BINS = 100;    // Bins spanning [0, blink_max_seconds]
+
+        struct Blink
+        {
+            Clock::time_point end;
+            int64_t duration_us;
+            size_t bin;
+        };
+
+        double close_threshold_ = 0.0;
+        double open_threshold_ = 0.0;
+        int64_t min_duration_us_ = 0;
+        int64_t max_duration_us_ = 0;
+        Clock::duration window_{};
+
+        // Eye state with hysteresis
+        bool eyes_closed_ = false;
+        Clock::time_point closed_since_;
+
+        // Window contents
+        std::array<Blink, MAX_WINDOW_BLINKS> blinks_{};
+        size_t head_ = 0;
+        size_t size_ = 0;
+        std::array<uint32_t, HISTOGRAM_BINS> histogram_{};
+        int64_t duration_sum_us_ = 0;
+
+        size_t total_blinks_ = 0;
+        bool started_ = false;
+        Clock::time_point first_update_;
+        Clock::time_point last_update_;
+
+        void push(const Blink &blink);
+        void popOldest();
+        void evictBefore(Clock::time_point cutoff);
+
+    public:
+        BlinkDetector() = default;
+        explicit BlinkDetector(const Config &config);
+
+        // Takes thresholds and window from the config and clears all state
+        void configure(const Config &config);
+
+        // Feeds one frame; returns true and fills event when a blink ended on this frame
+        bool update(double ear, Clock::time_point now, BlinkEvent &event);
+
+        // Statistics as of the last update()
+        BlinkStats getStats() const;
+    };
+}
+
+#endif // BLINK_DETECTOR_H
@@ -0,0 +1,67 @@
+#ifndef CHUNKED_VIDEO_PROCESSOR_H
+#define CHUNKED_VIDEO_PROCESSOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "config.h"
+#include "landmark_predictor.h"
+#include "driver_state.h"
+
+namespace DrowsinessDetector
+{
+    // Event produced by a chunk worker, logged after all chunks are merged
+    struct ChunkEvent
+    {
+        double media_time_ms = 0.0;
+        DriverState state = DriverState::ALERT;
+        double ear = 0.0;
+        double mar = 0.0;
+        double head_yaw = 0.0;
+        double perclos = -1.0;
+        BlinkStats blink_stats;
+        double blink_duration = -1.0; // Blink that ended on this frame, -1 when none
+        std::string message;
+    };
+
+    /**
+     * @brief Offline reprocessing of one video file split into N time ranges
+     *
+     * Each worker owns its own FrameAnalyzer (detector + tracker, sharing one
+     * read-only shape predictor) in event-time
+     * mode and first replays a warm-up overlap before its range without emitting
+     * events, so eye-closure and distraction timers are already running when the
+     * range starts. Per-chunk events are merged in timestamp order and logged.
+     */
+    class ChunkedVideoProcessor
+    {
+    private:
+        struct ChunkRange
+        {
+            int index = 0;
+            long long first_frame = 0;  // First frame whose events are emitted
+            long long end_frame = 0;    // One past the last frame of the chunk
+            long long warmup_frame = 0; // Where decoding starts
+        };
+
+        struct ChunkOutput
+        {
+            std::vector<ChunkEvent> events;
+            size_t processed_frames = 0;
+            bool ok = false;
+        };
+
+        Config config_;
+        std::shared_ptr<const LandmarkPredictor> landmark_predictor_;
+
+        void processChunk(const ChunkRange &range, const Config &analyzer_config, ChunkOutput &output);
+
+    public:
+        ChunkedVideoProcessor(const Config &config, std::shared_ptr<const LandmarkPredictor> landmark_predictor);
+
+        // Processes config.video_path with config.offline_workers workers
+        int run();
+    };
+}
+
+#endif // CHUNKED_VIDEO_PROCESSOR_H
@@ -2,10 +2,36 @@
 #define CONFIG_H
 
 #include <string>
+#include <vector>
 #include <opencv2/opencv.hpp>
 
 namespace DrowsinessDetector
 {
+    // Face detection backends selectable through Config::face_detector_backend
+    enum class FaceDetectorBackend
+    {
+        HOG,  // dlib frontal-face HOG (default)
+        HAAR, // OpenCV Haar cascade
+        YUNET // OpenCV DNN YuNet, needs OpenCV 4.5.4+
+    };
+
+    // Maps another detector's face box onto dlib HOG box geometry, which the shape predictor was
+    // trained on: the centre moves by offset * box size, then width and height are scaled
+    struct FaceBoxCalibration
+    {
+        double offset_x = 0.0;
+        double offset_y = 0.0;
+        double scale_x = 1.0;
+        double scale_y = 1.0;
+    };
+
+    // Cheap presence check run before the face detector while no face is visible
+    enum class PresenceGateMode
+    {
+        OFF,
+        CASCADE, // Haar cascade on a heavily downscaled frame
+        MOTION   // Frame-difference energy on a heavily downscaled frame
+    };
 
     struct Config
     {
@@ -14,6 +40,25 @@ namespace DrowsinessDetector
         double mar_threshold = 0.7;
         double drowsy_time_seconds = 2.0;
 
+        // PERCLOS trigger: DROWSY while the eyes were closed (EAR < ear_threshold) for at least
+        // perclos_threshold of the last perclos_window_seconds, even if no single closure lasts
+        // drowsy_time_seconds. Only fires once a full window has been observed (offline chunked
+        // mode extends each chunk's warm-up to the window)
+        bool enable_perclos = false;
+        double perclos_window_seconds = 60.0;
+        double perclos_frame_rate = 30.0; // Nominal rate; sets the bucket size, faster sources share buckets
+        double perclos_threshold = 0.15;  // Closed share of the window
+
+        // Blink detection: a blink starts when EAR drops below ear_threshold and ends once it
+        // rises above ear_threshold + blink_hysteresis. Each blink is logged and published as an
+        // event (also while ALERT) with its duration; rate and mean/p95 duration cover the last
+        // blink_window_seconds and accompany every event
+        bool enable_blink_detection = false;
+        double blink_hysteresis = 0.03;
+        double blink_min_seconds = 0.05;   // Shorter closures are landmark jitter
+        double blink_max_seconds = 1.0;    // Longer closures are left to the drowsiness timers
+        double blink_window_seconds = 60.0;
+
         // NEW: Head pose detection thresholds
         // double head_pose_yaw_left_threshold = -15.0;   // degrees
         // double head_pose_yaw_right_threshold = 15.0;   // degrees
@@ -63,14 +108,126 @@ namespace DrowsinessDetector
         // std::string video_path = "Videos/Veo3_5.mp4";
         // std::string video_path = "Videos/Veo3_6.mp4";
 
+        // Landmark engine: the in-tree flat engine runs dlib's model over contiguous arrays,
+        // loading the precompiled flat_model_path (memory-mapped) when present, else model_path.
+        // Tracked frames make no heap allocations in FrameAnalyzer::analyze only with this engine,
+        // enable_face_tracking and head pose off (dlib's engine and cv::solvePnP allocate per frame)
+        bool use_flat_shape_predictor = false;
+        std::string flat_model_path = "models/shape_predictor_68_face_landmarks.flat";
+
+        // Warm start (flat engine only): landmarks start from the previous frame's shape and
+        // only the last K cascade levels run; the full cascade runs after large motion or every N frames,
+        // and reruns when the warm-started shape moved more than warm_start_max_motion from the previous one
+        bool enable_warm_start = false;
+        int warm_start_levels = 4;             // K
+        double warm_start_max_motion = 0.1;    // Box shift or size change, relative to its width
+        int warm_start_refresh_interval = 10;  // N
+
         // Performance settings
-        int frame_skip = 1; // Process every N frames
+        int frame_skip = 1; // Process every N frames; skipped frames are grabbed, not decoded
+        bool seek_on_frame_skip = false; // Video files: seek straight to the next processed frame (pays off for large skips)
+
+        // Face detector backend and the model files of the OpenCV alternatives
+        FaceDetectorBackend face_detector_backend = FaceDetectorBackend::HOG;
+        std::string haar_cascade_path = "models/haarcascade_frontalface_default.xml";
+        double haar_scale_factor = 1.1;
+        int haar_min_neighbors = 5;
+        std::string yunet_model_path = "models/face_detection_yunet_2023mar.onnx";
+        double yunet_score_threshold = 0.9;
+        // Haar boxes are larger than HOG's and YuNet's taller (forehead); face_detector_benchmark
+        // prints the calibration that matches HOG on a camera's footage, to replace these with
+        FaceBoxCalibration haar_box_calibration = {0.0, 0.06, 0.85, 0.85};
+        FaceBoxCalibration yunet_box_calibration = {0.0, 0.10, 0.95, 0.85};
+
+        // Face detection runs on a grayscale copy downscaled by this factor (e.g. 0.5, 0.25) and
+        // boxes are mapped back; landmarks stay full resolution. 1.0 scans the BGR frame as is.
+        // dlib's HOG window is 80x80, so faces smaller than 80/scale pixels are missed
+        double detection_scale = 1.0;
+
+        // HOG pyramid for in-cabin geometry, still using dlib's frontal-face weights.
+        // The defaults reproduce get_frontal_face_detector()
+        int hog_pyramid_downsample = 6; // pyramid_down<N>: each level is (N-1)/N of the previous, N in 2..6
+        int hog_max_pyramid_levels = 0; // Caps the largest detectable face; 0 = dlib default
+        int hog_min_face_size = 0;      // Smallest driver face in pixels; above 80 the frame is pre-downscaled (also the Haar minSize)
+        // Pyramid levels scanned in parallel by N workers; 1 = single-threaded, 0 = all cores.
+        // Each detector owns its pool: in multi-stream and chunked mode every stream/chunk has one,
+        // so 0 becomes an equal share of the cores per detector and larger values are capped to it
+        int hog_threads = 1;
+
+        // Driver-seat region prior (per vehicle install): only this part of the frame is scanned
+        // and faces centred outside it are discarded, so passengers are never detected or tracked
+        bool enable_driver_region = false;
+        cv::Rect2d driver_region = cv::Rect2d(0.0, 0.0, 1.0, 1.0); // Normalized x, y, width, height
+
+        // Presence gate: while no face is visible, the full detector only runs when a cheap
+        // check suggests someone is there; every N-th rejected frame is audited anyway
+        PresenceGateMode presence_gate_mode = PresenceGateMode::OFF;
+        double presence_gate_scale = 0.25;
+        std::string presence_gate_cascade_path = "models/haarcascade_frontalface_default.xml";
+        double presence_motion_threshold = 2.0; // Mean absolute grey-level difference that counts as motion
+        int presence_gate_audit_interval = 30;  // N; 0 disables audits
+
+        // ROI re-detection: the face detector scans only an expanded window around the
+        // previous face, with a full-frame scan after a miss or every K frames
+        bool enable_roi_redetection = false;
+        double roi_expansion = 2.0;      // Search window size relative to the previous face box
+        int roi_full_scan_interval = 30; // K
+
+        // Detect-once-then-track: between detections the face box is derived from the
+        // previous frame's landmarks; HOG reruns when landmarks jump, when the face no longer
+        // looks like the one last detected, or every N frames. Shape regression always returns
+        // a face-shaped result, so the appearance check is what catches a face that left or is
+        // covered; with it disabled such frames can feed EAR/MAR for up to N frames
+        bool enable_face_tracking = false;
+        int tracking_redetect_interval = 15;    // N
+        double tracking_max_shift = 0.15;       // Max landmark-box centre shift per frame, relative to its size
+        double tracking_max_scale_change = 0.15; // Max relative landmark-box width change per frame
+        double tracking_min_appearance = 0.5;   // Min correlation with the face patch at the last detection, 0 disables
+
+        // Adaptive frame rate: replaces frame_skip with a stride chosen from the driver's
+        // state; full rate whenever EAR nears ear_threshold, a timer runs or the head turns
+        bool enable_adaptive_frame_rate = false;
+        double adaptive_cpu_budget = 0.5;  // Share of one core inference may use while the driver is clearly alert
+        int adaptive_max_stride = 4;       // Never process fewer than every N-th frame
+        double adaptive_ear_margin = 0.2;  // EAR more than 20% above ear_threshold counts as far
+        double adaptive_mar_margin = 0.2;  // MAR more than 20% below mar_threshold counts as far
+        int adaptive_relax_frames = 10;    // Consecutive clearly-alert frames before slowing down
+
+        // Event-time mode: for video files the state timers follow each frame's
+        // presentation timestamp, so replay speed does not change the DROWSY timeline
+        bool use_video_timestamps = false;
+
+        // Offline chunked mode: a video file is split into N time ranges processed by N
+        // workers, each with its own detector and tracker; 0 or 1 keeps sequential processing
+        int offline_workers = 0;
+        double chunk_warmup_seconds = 5.0; // Overlap replayed before each chunk so timers are correct at its start;
+                                           // raised to the longest timer and enabled PERCLOS/blink window
+
+        // Multi-stream mode: one process monitors every source listed here (camera index,
+        // file path or URL) with a shared shape predictor; always headless
+        std::vector<std::string> stream_sources;
+        int stream_worker_threads = 0; // 0 = cores divided by the HOG threads each stream's detector gets
+
+        // Per-frame deadline: once a frame has used this many ms, optional stages (head
+        // pose, overlays, snapshots) are shed; EAR and the state update always run. 0 disables
+        double frame_budget_ms = 0.0;
+        int max_pose_reuse_frames = 3; // Consecutive shed frames that may reuse the last pose before it is estimated anyway
+
+        // Pipelined mode: capture, inference and render/log run on separate threads
+        bool enable_pipeline = false;
+        int pipeline_queue_capacity = 4; // Preallocated frames circulating between stages
+
+        // Latest-frame-wins capture: a grabber thread keeps only the newest frame and
+        // stale frames are dropped, bounding glass-to-alert latency. Video files are
+        // read at their native fps to behave like a live camera. frame_skip does not apply.
+        bool latest_frame_capture = false;
 
         // Zero Mq Configurations
         std::string zmq_endpoint = "tcp://*:5555";
         bool enable_publishing_ = false;
 
         // Display settings
+        bool headless = false; // No overlays, windows or waitKey; stop with SIGINT/SIGTERM instead of ESC
         bool show_debug_info = true;
         cv::Scalar alert_color = cv::Scalar(0, 255, 0);
         cv::Scalar warning_color = cv::Scalar(0, 165, 255);
@@ -1,6 +1,9 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <array>
+#include <cstddef>
+
 namespace DrowsinessDetector
 {
     namespace Constants
@@ -9,15 +12,42 @@ namespace DrowsinessDetector
         constexpr int WAIT_KEY_MS = 3;
         constexpr double EPSILON = 1e-6;
         constexpr int MAX_LOG_ENTRIES = 1000;
-        constexpr int FACE_LANDMARK_COUNT = 68;
     }
 
-    namespace LandmarkIndices
+    // Two landmarks whose distance enters an aspect ratio
+    struct PointPair
+    {
+        int from;
+        int to;
+    };
+
+    // Aspect ratio = sum of the vertical distances / (2 * horizontal distance)
+    template <size_t Verticals>
+    struct AspectRatioTable
     {
-        constexpr int LEFT_EYE_START = 42, LEFT_EYE_END = 47;
-        constexpr int RIGHT_EYE_START = 36, RIGHT_EYE_END = 41;
-        constexpr int MOUTH_START = 60, MOUTH_END = 67;
+        std::array<PointPair, Verticals> verticals;
+        PointPair horizontal;
+    };
+
+    // Landmark subsets per model, all compile-time constants. Another model (e.g. 98-point WFLW)
+    // needs a layout here plus a shape model with that many parts; LandmarkPredictor::load
+    // rejects models that do not match LandmarkLayout::POINTS
+    namespace LandmarkLayouts
+    {
+        struct Points68
+        {
+            static constexpr int POINTS = 68;
+            static constexpr int NOSE_TIP = 30;
+            static constexpr AspectRatioTable<2> LEFT_EYE = {{{{43, 47}, {44, 46}}}, {42, 45}};
+            static constexpr AspectRatioTable<2> RIGHT_EYE = {{{{37, 41}, {38, 40}}}, {36, 39}};
+            static constexpr AspectRatioTable<3> MOUTH = {{{{63, 67}, {62, 66}, {61, 65}}}, {60, 64}}; // Inner lips
+            // Nose tip, chin, outer eye corners, mouth corners: HeadPoseDetector's 3D model order
+            static constexpr std::array<int, 6> HEAD_POSE = {30, 8, 36, 45, 48, 54};
+        };
     }
+
+    // The layout of the shipped dlib model (shape_predictor_68_face_landmarks.dat)
+    using LandmarkLayout = LandmarkLayouts::Points68;
 }
 
-#endif // CONSTANTS_H
\ No newline at end of file
+#endif // CONSTANTS_H
@@ -3,18 +3,68 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 #include <opencv2/opencv.hpp>
 #include "driver_state.h"
 #include "config.h"
+#include "constants.h"
+#include "face_landmarks.h"
 
 namespace DrowsinessDetector
 {
     namespace CVUtils
     {
-        double calculateEAR(const std::vector<cv::Point2f> &eye_points);
-        double calculateMAR(const std::vector<cv::Point2f> &mouth_points);
+        namespace detail
+        {
+            template <int From, int To>
+            double distance(const FaceLandmarks &landmarks)
+            {
+                return cv::norm(landmarks.point(From) - landmarks.point(To));
+            }
+
+            template <const auto &Table, size_t... I>
+            double verticalSum(const FaceLandmarks &landmarks, std::index_sequence<I...>)
+            {
+                return (... + distance<Table.verticals[I].from, Table.verticals[I].to>(landmarks));
+            }
+        }
+
+        // Aspect ratio over a LandmarkLayouts table; every index is a template argument,
+        // so the gathers and the distance sum unroll completely
+        template <const auto &Table>
+        double aspectRatio(const FaceLandmarks &landmarks)
+        {
+            if (!landmarks.isComplete())
+                return 0.0;
+
+            const double vertical = detail::verticalSum<Table>(landmarks, std::make_index_sequence<Table.verticals.size()>());
+            const double horizontal = detail::distance<Table.horizontal.from, Table.horizontal.to>(landmarks);
+            return (horizontal < Constants::EPSILON) ? 0.0 : vertical / (2.0 * horizontal);
+        }
+
+        // Scalar reference versions; the per-frame path uses FaceRatioKernel
+        template <typename Layout = LandmarkLayout>
+        double calculateEAR(const FaceLandmarks &landmarks)
+        {
+            static_assert(Layout::POINTS == FaceLandmarks::MAX_POINTS, "Layout differs from the built landmark model");
+            return (aspectRatio<Layout::LEFT_EYE>(landmarks) + aspectRatio<Layout::RIGHT_EYE>(landmarks)) / 2.0;
+        }
+
+        template <typename Layout = LandmarkLayout>
+        double calculateMAR(const FaceLandmarks &landmarks)
+        {
+            static_assert(Layout::POINTS == FaceLandmarks::MAX_POINTS, "Layout differs from the built landmark model");
+            return aspectRatio<Layout::MOUTH>(landmarks);
+        }
+
         cv::Scalar getStateColor(DriverState state, const Config &config);
         std::string formatDouble(double value, int precision = 3);
+
+        // Moves past the frames frame_skip discards without decoding them (grab(), or one
+        // seek when seek is set and the source is a file), then decodes the next processed
+        // frame. frame_count is the 1-based number of the last frame consumed.
+        bool readNextProcessedFrame(cv::VideoCapture &cap, cv::Mat &frame, long long &frame_count,
+                                    int frame_skip, bool seek = false);
     }
 }
 
@@ -0,0 +1,24 @@
+#ifndef DLIB_LANDMARK_PREDICTOR_H
+#define DLIB_LANDMARK_PREDICTOR_H
+
+#include <dlib/image_processing.h>
+#include "landmark_predictor.h"
+
+namespace DrowsinessDetector
+{
+    // dlib::shape_predictor deserialized from the .dat model
+    class DlibLandmarkPredictor : public LandmarkPredictor
+    {
+    private:
+        dlib::shape_predictor predictor_;
+
+    public:
+        bool load(const std::string &model_path);
+
+        void predict(const cv::Mat &frame, const dlib::rectangle &face, FaceLandmarks &landmarks) const override;
+        std::string getName() const override { return "dlib"; }
+        size_t getNumParts() const override { return predictor_.num_parts(); }
+    };
+}
+
+#endif // DLIB_LANDMARK_PREDICTOR_H
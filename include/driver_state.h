@@ -4,6 +4,8 @@
 #include <chrono>
 #include "config.h"
 #include "head_pose_detector.h"
+#include "perclos_window.h"
+#include "blink_detector.h"
 
 namespace DrowsinessDetector
 {
@@ -27,7 +29,27 @@ namespace DrowsinessDetector
         bool distraction_timer_active_ = false;
         DriverState last_state_ = DriverState::ALERT;
 
+        // Event-time mode: durations follow frame timestamps instead of the wall clock
+        bool use_event_time_ = false;
+        std::chrono::steady_clock::time_point event_time_;
+
+        // PERCLOS over Config::perclos_window_seconds; each sample covers the time since the previous one
+        PerclosWindow perclos_;
+        bool perclos_configured_ = false;
+        bool have_perclos_sample_ = false;
+        std::chrono::steady_clock::time_point last_perclos_sample_;
+
+        // Blink segmentation, configured on first use
+        BlinkDetector blink_detector_;
+        bool blink_detector_configured_ = false;
+        bool blink_ended_ = false;
+        BlinkEvent last_blink_;
+
+        std::chrono::steady_clock::time_point now() const;
+
         bool checkDrowsiness(double ear, const Config &config);
+        bool checkPerclos(bool eyes_closed, const Config &config);
+        void updateBlinks(double ear, const Config &config);
         bool checkYawning(double mar, const Config &config);
         bool checkDistraction(const HeadPose &head_pose, const Config &config);
         DriverState getCurrentDriverState(bool is_drowsy, bool is_yawning, bool is_distracted) const;
@@ -41,9 +63,22 @@ namespace DrowsinessDetector
         DriverState updateState(double ear, double mar, const HeadPose &head_pose, const Config &config);
         DriverState updateState(double ear, double mar, const Config &config);
 
+        // Switches the tracker to event time; call before updateState with the frame's presentation time
+        void setFrameTimestamp(double timestamp_ms);
+
         DriverState getLastState() const { return last_state_; }
+        bool isEyesClosedTimerActive() const { return eyes_closed_timer_active_; }
+        bool isDistractionTimerActive() const { return distraction_timer_active_; }
         double getEyesClosedDuration() const;
         double getDistractionDuration() const;
+
+        // Share of the PERCLOS window with eyes closed, 0 until Config::enable_perclos feeds it
+        double getPerclos() const { return perclos_.getPerclos(); }
+
+        // Blink events and statistics while Config::enable_blink_detection is set
+        bool didBlinkEnd() const { return blink_ended_; } // On the last updateState()
+        const BlinkEvent &getLastBlink() const { return last_blink_; }
+        BlinkStats getBlinkStats() const { return blink_detector_.getStats(); }
     };
 }
 
@@ -5,8 +5,12 @@
 #include <opencv2/opencv.hpp>
 #include "config.h"
 #include "driver_state.h"
-#include "facial_landmark_detector.h"
 #include "head_pose_detector.h"
+#include "frame_pipeline.h"
+#include "frame_analyzer.h"
+#include "latest_frame_grabber.h"
+#include "adaptive_rate_controller.h"
+#include "frame_deadline.h"
 
 namespace DrowsinessDetector
 {
@@ -14,35 +18,45 @@ namespace DrowsinessDetector
     {
     private:
         Config config_;
-        std::unique_ptr<FacialLandmarkDetector> detector_;
-        std::unique_ptr<HeadPoseDetector> head_pose_detector_;
-        std::unique_ptr<StateTracker> state_tracker_;
-        bool have_previous_face_location = false;
-        cv::Rect last_face_rect_;
+        std::shared_ptr<const LandmarkPredictor> landmark_predictor_; // Loaded once, shared by every analyzer
+        std::unique_ptr<FrameAnalyzer> analyzer_;
+        std::unique_ptr<LatestFrameGrabber> frame_grabber_;
+        std::unique_ptr<AdaptiveRateController> rate_controller_;
+        bool is_file_source_ = false;
+        DeadlineStats deadline_stats_;
 
     public:
         explicit DrowsinessDetectionSystem(const Config &config);
         bool initialize();
         int run();
 
+        // Degradation counters for Config::frame_budget_ms
+        const DeadlineStats &getDeadlineStats() const { return deadline_stats_; }
+
     private:
-        void processFrame(cv::Mat &frame);
+        bool openVideoSource(cv::VideoCapture &cap);
+        bool readFrame(cv::VideoCapture &cap, cv::Mat &frame, double &timestamp_ms, long long &frame_count);
+        bool shouldStop();
+        int runSequential(cv::VideoCapture &cap);
+        int runPipelined(cv::VideoCapture &cap);
+
+        void processFrame(cv::Mat &frame, double timestamp_ms);
+        FrameResult analyzeFrame(const cv::Mat &frame, double timestamp_ms);
+        void renderFrame(cv::Mat &frame, const FrameResult &result);
+        void logFrameResult(const cv::Mat &frame, const FrameResult &result, const FrameDeadline &deadline);
         void drawNoFaceDetected(cv::Mat &frame);
 
         // without head pose visualization
         // void drawVisualization(cv::Mat &frame, const cv::Rect &face_rect, DriverState state,
         //                        double ear, double mar);
 
-        void drawVisualization(cv::Mat &frame, const cv::Rect &face_rect, DriverState state,
-                               double ear, double mar, const HeadPose &head_pose);
+        void drawVisualization(cv::Mat &frame, const FrameResult &result, const HeadPose &head_pose);
 
-        void drawVisualization(cv::Mat &frame, const cv::Rect &face_rect, DriverState state,
-                                                          double ear, double mar);
+        void drawVisualization(cv::Mat &frame, const FrameResult &result);
 
             void drawHeadPoseVisualization(cv::Mat &frame, const HeadPose &head_pose,
-                                           const dlib::full_object_detection &landmarks);
+                                           const FaceLandmarks &landmarks);
 
-        std::string generateStateMessage(DriverState state);
         void cleanup();
     };
 }
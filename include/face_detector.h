@@ -0,0 +1,46 @@
+#ifndef FACE_DETECTOR_H
+#define FACE_DETECTOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <dlib/geometry/rectangle.h>
+#include "config.h"
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief Face detection backend used by FacialLandmarkDetector
+     *
+     * Boxes are returned as dlib rectangles in image coordinates since they go
+     * straight to the shape predictor, and in dlib HOG box geometry since that
+     * is what the predictor was trained on; other backends map theirs with a
+     * FaceBoxCalibration. Implementations keep per-instance scratch state and
+     * are not thread-safe; each analyzer owns its own detector.
+     */
+    class FaceDetector
+    {
+    protected:
+        // Box given as x, y, width, height in the backend's own geometry
+        static dlib::rectangle toHogGeometry(double x, double y, double width, double height,
+                                             const FaceBoxCalibration &calibration);
+
+    public:
+        virtual ~FaceDetector() = default;
+
+        // Accepts BGR or 8-bit grayscale images
+        virtual std::vector<dlib::rectangle> detect(const cv::Mat &image) = 0;
+
+        virtual std::string getName() const = 0;
+
+        // Largest pre-scale that still finds the smallest face of interest (1.0 = scan full size)
+        virtual double getMinFaceScale() const { return 1.0; }
+
+        // Builds the backend selected by Config::face_detector_backend; nullptr on failure
+        static std::unique_ptr<FaceDetector> create(const Config &config);
+        static std::unique_ptr<FaceDetector> create(FaceDetectorBackend backend, const Config &config);
+    };
+}
+
+#endif // FACE_DETECTOR_H
@@ -0,0 +1,66 @@
+#ifndef FACE_LANDMARKS_H
+#define FACE_LANDMARKS_H
+
+#include <algorithm>
+#include <opencv2/core.hpp>
+#include <dlib/image_processing/full_object_detection.h>
+#include "constants.h"
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief One face's landmarks in frame coordinates, structure-of-arrays
+     *
+     * Fixed capacity and no heap storage: the detector fills one instance per
+     * stream every frame and EAR/MAR/head pose read the x/y arrays in place.
+     * count is 0 when no landmarks are available.
+     */
+    struct FaceLandmarks
+    {
+        static constexpr int MAX_POINTS = LandmarkLayout::POINTS;
+
+        alignas(16) float x[MAX_POINTS] = {};
+        alignas(16) float y[MAX_POINTS] = {};
+        int count = 0;
+
+        bool isComplete() const { return count == MAX_POINTS; }
+        void clear() { count = 0; }
+
+        cv::Point2f point(int i) const { return cv::Point2f(x[i], y[i]); }
+        dlib::point dlibPoint(int i) const { return dlib::point(static_cast<long>(x[i]), static_cast<long>(y[i])); }
+
+        // Copies a dlib detection; a shape larger than MAX_POINTS leaves count at 0
+        void assign(const dlib::full_object_detection &detection)
+        {
+            const unsigned long parts = detection.num_parts();
+            count = 0;
+            if (parts > static_cast<unsigned long>(MAX_POINTS))
+                return;
+            for (unsigned long i = 0; i < parts; ++i)
+            {
+                x[i] = static_cast<float>(detection.part(i).x());
+                y[i] = static_cast<float>(detection.part(i).y());
+            }
+            count = static_cast<int>(parts);
+        }
+
+        // Tight bounding box of all points; empty when count is 0
+        dlib::rectangle bounds() const
+        {
+            if (count == 0)
+                return dlib::rectangle();
+            float left = x[0], right = x[0], top = y[0], bottom = y[0];
+            for (int i = 1; i < count; ++i)
+            {
+                left = std::min(left, x[i]);
+                right = std::max(right, x[i]);
+                top = std::min(top, y[i]);
+                bottom = std::max(bottom, y[i]);
+            }
+            return dlib::rectangle(static_cast<long>(left), static_cast<long>(top),
+                                   static_cast<long>(right), static_cast<long>(bottom));
+        }
+    };
+}
+
+#endif // FACE_LANDMARKS_H
@@ -0,0 +1,40 @@
+#ifndef FACE_RATIO_KERNEL_H
+#define FACE_RATIO_KERNEL_H
+
+#include <cstddef>
+#include "face_landmarks.h"
+
+namespace DrowsinessDetector
+{
+    struct FaceRatios
+    {
+        double left_ear = 0.0;
+        double right_ear = 0.0;
+        double mar = 0.0;
+
+        double ear() const { return (left_ear + right_ear) / 2.0; }
+    };
+
+    /**
+     * @brief Both eye aspect ratios and the mouth aspect ratio in one pass
+     *
+     * The ten point-to-point distances behind EAR/MAR (three per eye, four for
+     * the inner lips, per the LandmarkLayout tables) are gathered from the x/y
+     * arrays and evaluated together with SSE2 or NEON, falling back to scalar
+     * code elsewhere. Results follow
+     * CVUtils::calculateEAR/calculateMAR except that the distances are taken in
+     * float; incomplete landmark sets give all zeros.
+     */
+    namespace FaceRatioKernel
+    {
+        FaceRatios compute(const FaceLandmarks &landmarks);
+
+        // Offline reanalysis: one lane per frame, four frames per vector
+        void computeBatch(const FaceLandmarks *landmarks, size_t count, FaceRatios *ratios);
+
+        // "SSE2", "NEON" or "scalar"
+        const char *getInstructionSet();
+    }
+}
+
+#endif // FACE_RATIO_KERNEL_H
@@ -1,36 +1,109 @@
 #ifndef FACIAL_LANDMARK_DETECTOR_H
 #define FACIAL_LANDMARK_DETECTOR_H
 
+#include <array>
 #include <string>
 #include <vector>
+#include <memory>
 #include <opencv2/opencv.hpp>
 #include <dlib/opencv.h>
 #include <dlib/image_processing/frontal_face_detector.h>
 #include <dlib/image_processing.h>
+#include "config.h"
+#include "face_detector.h"
+#include "presence_gate.h"
+#include "landmark_predictor.h"
+#include "face_landmarks.h"
 
 namespace DrowsinessDetector
 {
+    // Landmark cascade work, to measure what warm starts save
+    struct LandmarkCostStats
+    {
+        size_t predictions = 0;
+        size_t warm_starts = 0;
+        size_t warm_start_fallbacks = 0; // Warm starts whose shape moved too far and were redone in full
+        size_t levels_run = 0;  // Cascade levels evaluated
+        size_t levels_full = 0; // Levels a full cascade on every prediction would have evaluated
+    };
+
     class FacialLandmarkDetector
     {
     private:
-        dlib::frontal_face_detector face_detector_;
-        dlib::shape_predictor landmark_predictor_;
+        static constexpr int APPEARANCE_SIZE = 24; // Side of the grayscale face patch compared while tracking
+        using AppearancePatch = std::array<float, APPEARANCE_SIZE * APPEARANCE_SIZE>;
+
+        Config config_;
+        std::unique_ptr<FaceDetector> face_detector_; // Backend chosen by Config::face_detector_backend
+        std::unique_ptr<PresenceGate> presence_gate_; // Only when Config::presence_gate_mode is set
+        std::shared_ptr<const LandmarkPredictor> landmark_predictor_;
         bool is_initialized_ = false;
 
+        // ROI re-detection: where the face was last seen and how long since a full-frame scan
+        bool have_previous_face_location_ = false;
+        cv::Rect last_face_rect_;
+        int frames_since_full_scan_ = 0;
+
+        // Detect-once-then-track: the next face box is derived from these landmarks
+        bool have_tracked_face_ = false;
+        dlib::rectangle previous_landmark_box_;
+        int frames_since_detection_ = 0;
+        // Detector box relative to the landmark bounding box, measured at the last real detection
+        double box_offset_x_ = 0.0, box_offset_y_ = 0.0;
+        double box_scale_x_ = 1.0, box_scale_y_ = 1.0;
+        // Zero-mean, unit-norm face patch sampled at the last real detection
+        bool have_face_template_ = false;
+        AppearancePatch face_template_;
+
+        // Tracking statistics
+        size_t frames_tracked_ = 0;
+        size_t frames_detected_ = 0;
+
+        // Warm start: previous landmarks and the box they were predicted in
+        bool have_previous_landmarks_ = false;
+        FaceLandmarks previous_landmarks_;
+        dlib::rectangle previous_face_box_;
+        int frames_since_full_cascade_ = 0;
+        LandmarkCostStats landmark_cost_;
+
+        // Downscaled detection: reused grayscale and resized buffers
+        cv::Mat gray_buffer_;
+        cv::Mat scaled_buffer_;
+
     public:
+        explicit FacialLandmarkDetector(const Config &config = Config());
+
         bool initialize(const std::string &model_path);
 
-        bool detectFaceAndAllLandmarks(const cv::Mat &frame, cv::Rect &face_rect,
-                                       std::vector<cv::Point2f> &left_eye,
-                                       std::vector<cv::Point2f> &right_eye,
-                                       std::vector<cv::Point2f> &mouth,
-                                       dlib::full_object_detection &all_landmarks);
+        // Shares an already loaded, read-only predictor; the face detector stays per instance
+        bool initialize(std::shared_ptr<const LandmarkPredictor> landmark_predictor);
+
+        // Writes the landmarks in place; with tracking or the presence gate in steady state
+        // a frame needs no heap allocation here
+        bool detectFaceAndLandmarks(const cv::Mat &frame, cv::Rect &face_rect, FaceLandmarks &landmarks);
+
+        // One stateless full-frame scan at Config::detection_scale, boxes in frame coordinates
+        std::vector<dlib::rectangle> detectFaces(const cv::Mat &frame);
+
+        // nullptr when the presence gate is off
+        const PresenceGateStats *getPresenceGateStats() const;
+
+        const LandmarkCostStats &getLandmarkCostStats() const { return landmark_cost_; }
+
+        // Frames whose face box came from tracking vs. from the HOG detector
+        void getTrackingStats(size_t &tracked, size_t &detected) const;
 
     private:
-        void extractEyePoints(const dlib::full_object_detection &landmarks, int start, int end,
-                              std::vector<cv::Point2f> &eye_points);
-        void extractMouthPoints(const dlib::full_object_detection &landmarks,
-                                std::vector<cv::Point2f> &mouth_points);
+        bool detectFace(const cv::Mat &frame, dlib::rectangle &face);
+        void predictLandmarks(const cv::Mat &frame, const dlib::rectangle &face, FaceLandmarks &landmarks);
+        bool isSmallMotion(const dlib::rectangle &previous, const dlib::rectangle &current) const;
+        cv::Rect driverRegion(const cv::Mat &frame) const;
+        dlib::rectangle trackedFaceBox() const;
+        bool isTrackingConsistent(const dlib::rectangle &landmark_box) const;
+        bool matchesAppearance(const cv::Mat &frame, const dlib::rectangle &landmark_box) const;
+        static bool sampleAppearance(const cv::Mat &frame, const dlib::rectangle &box, AppearancePatch &patch);
+        void updateTracking(const cv::Mat &frame, const dlib::rectangle &face, const FaceLandmarks &landmarks, bool tracked);
+        std::vector<dlib::rectangle> scanForFaces(const cv::Mat &frame, const cv::Rect &search_area);
     };
 }
 
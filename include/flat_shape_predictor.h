@@ -0,0 +1,99 @@
+#ifndef FLAT_SHAPE_PREDICTOR_H
+#define FLAT_SHAPE_PREDICTOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "landmark_predictor.h"
+
+namespace DrowsinessDetector
+{
+    // Layout of a flattened shape predictor; every array offset is in bytes from the start of the blob
+    struct FlatShapeModelHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t num_parts;          // Landmarks per shape, LandmarkLayout::POINTS
+        uint32_t num_levels;         // Cascade levels
+        uint32_t trees_per_level;
+        uint32_t tree_depth;         // Every tree is complete: 2^depth - 1 splits, 2^depth leaves
+        uint32_t features_per_level; // Feature pixels sampled per level
+        uint64_t initial_shape_offset; // float[2 * num_parts], x/y interleaved as in dlib
+        uint64_t anchors_offset;       // uint32[num_levels][features]
+        uint64_t deltas_offset;        // float[num_levels][2][features], x block then y block
+        uint64_t splits_offset;        // FlatSplit[num_levels][trees][2^depth - 1]
+        uint64_t leaves_offset;        // float[num_levels][trees][2^depth][2 * num_parts]
+        uint64_t total_size;
+        uint64_t source_size;  // Size of the .dat the blob was converted from
+        int64_t source_mtime;  // Its last write time, in file-clock ticks
+    };
+
+    struct FlatSplit
+    {
+        uint16_t idx1;
+        uint16_t idx2;
+        float thresh;
+    };
+
+    /**
+     * @brief dlib shape_predictor inference over contiguous arrays
+     *
+     * Parses shape_predictor_68_face_landmarks.dat directly into one blob per
+     * the FlatShapeModelHeader layout: per cascade level the feature anchors and
+     * deltas, then every tree's splits and leaf deltas back to back. The math
+     * follows dlib::shape_predictor::operator() operation for operation (float
+     * shape space, double image mapping, floor(x + 0.5) rounding, (r+g+b)/3
+     * intensity), so the landmarks match dlib's.
+     */
+    class FlatShapePredictor : public LandmarkPredictor
+    {
+    private:
+        std::vector<uint64_t> storage_;      // Owns the blob when parsed from a .dat, 8-byte aligned
+        std::shared_ptr<const void> mapping_; // Keeps a memory-mapped .flat file alive
+        const FlatShapeModelHeader *header_ = nullptr;
+        const float *initial_shape_ = nullptr;
+        const uint32_t *anchors_ = nullptr;
+        const float *deltas_ = nullptr;
+        const FlatSplit *splits_ = nullptr;
+        const float *leaves_ = nullptr;
+
+        // Validates the whole blob once (extents, part count, every anchor and split index)
+        // so inference needs no bounds checks; error says why it was rejected
+        bool attach(const unsigned char *blob, size_t size, std::string &error);
+        void sampleFeatures(const cv::Mat &frame, const dlib::rectangle &face, size_t level,
+                            const float *shape, float *features) const;
+        void runCascade(const cv::Mat &frame, const dlib::rectangle &face, std::vector<float> &shape,
+                        size_t first_level, FaceLandmarks &landmarks) const;
+
+    public:
+        static constexpr char MAGIC[8] = {'D', 'D', 'S', 'P', 'F', 'L', 'A', 'T'};
+        static constexpr uint32_t VERSION = 2;
+
+        // Parses a dlib .dat shape predictor; nullptr on failure
+        static std::shared_ptr<const FlatShapePredictor> loadDat(const std::string &model_path);
+
+        // Memory-maps a file written by saveFlat(); pages are read lazily and shared
+        // between processes through the page cache. When source_path exists, its size and
+        // write time must match the .dat the file was converted from. nullptr on failure
+        static std::shared_ptr<const FlatShapePredictor> loadFlat(const std::string &flat_path,
+                                                                  const std::string &source_path = "");
+
+        // Writes the blob as-is (native byte order) for loadFlat()
+        bool saveFlat(const std::string &flat_path) const;
+
+        void predict(const cv::Mat &frame, const dlib::rectangle &face, FaceLandmarks &landmarks) const override;
+        std::string getName() const override { return "flat"; }
+
+        bool supportsWarmStart() const override { return true; }
+        size_t getCascadeLevels() const override { return header_->num_levels; }
+        void predictFrom(const cv::Mat &frame, const dlib::rectangle &face, const FaceLandmarks &start,
+                         size_t levels, FaceLandmarks &landmarks) const override;
+
+        size_t getNumParts() const override { return header_->num_parts; }
+        size_t getNumLevels() const { return header_->num_levels; }
+        size_t getModelBytes() const { return header_->total_size; }
+    };
+}
+
+#endif // FLAT_SHAPE_PREDICTOR_H
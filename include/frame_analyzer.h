@@ -0,0 +1,58 @@
+#ifndef FRAME_ANALYZER_H
+#define FRAME_ANALYZER_H
+
+#include <memory>
+#include <string>
+#include <opencv2/opencv.hpp>
+#include "config.h"
+#include "driver_state.h"
+#include "facial_landmark_detector.h"
+#include "head_pose_detector.h"
+#include "frame_pipeline.h"
+#include "frame_deadline.h"
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief Per-stream inference: face/landmark detection, EAR/MAR, head pose and state tracking
+     *
+     * Owns everything that must not be shared between independent video streams,
+     * so several analyzers can run side by side on different threads.
+     */
+    class FrameAnalyzer
+    {
+    private:
+        Config config_;
+        std::unique_ptr<FacialLandmarkDetector> detector_;
+        std::unique_ptr<HeadPoseDetector> head_pose_detector_;
+        std::unique_ptr<StateTracker> state_tracker_;
+        bool use_event_time_ = false;
+        // Reused when the frame budget sheds pose estimation, for at most Config::max_pose_reuse_frames
+        // frames in a row and never across a frame without a face
+        HeadPose last_head_pose_;
+        bool have_last_head_pose_ = false;
+        int pose_reuse_count_ = 0;
+
+    public:
+        explicit FrameAnalyzer(const Config &config);
+        bool initialize();
+        bool initialize(std::shared_ptr<const LandmarkPredictor> landmark_predictor);
+
+        // Event time: state timers follow the timestamps passed to analyze() instead of the wall clock
+        void setUseEventTime(bool enabled) { use_event_time_ = enabled; }
+
+        // With a deadline, head pose is skipped once it has expired; EAR/MAR and the state update always run
+        FrameResult analyze(const cv::Mat &frame, double timestamp_ms, const FrameDeadline *deadline = nullptr);
+
+        bool isHeadPoseActive() const;
+        const FacialLandmarkDetector &getLandmarkDetector() const { return *detector_; }
+
+        static std::string generateStateMessage(DriverState state);
+
+        // Log paths record non-ALERT frames and, with blink detection, every frame a blink ended on
+        static bool shouldLog(const FrameResult &result);
+        static std::string generateLogMessage(const FrameResult &result);
+    };
+}
+
+#endif // FRAME_ANALYZER_H
@@ -0,0 +1,49 @@
+#ifndef FRAME_DEADLINE_H
+#define FRAME_DEADLINE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace DrowsinessDetector
+{
+    // How often the per-frame budget forced optional stages to be shed
+    struct DeadlineStats
+    {
+        std::atomic<size_t> frames{0};
+        std::atomic<size_t> deadline_misses{0};   // Frames that finished over budget
+        std::atomic<size_t> pose_skipped{0};      // Head pose reused from the previous frame
+        std::atomic<size_t> overlays_skipped{0};  // Frames shown without overlays
+        std::atomic<size_t> snapshots_skipped{0}; // Events logged without a snapshot
+    };
+
+    /**
+     * @brief Per-frame time budget
+     *
+     * Stages ask expired() before running; optional work (head pose, overlays,
+     * snapshots) is shed once the budget is spent, while EAR and the state update
+     * always run. A budget of 0 never expires.
+     */
+    class FrameDeadline
+    {
+    private:
+        std::chrono::steady_clock::time_point start_;
+        double budget_ms_;
+
+    public:
+        explicit FrameDeadline(double budget_ms,
+                               std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now())
+            : start_(start), budget_ms_(budget_ms) {}
+
+        std::chrono::steady_clock::time_point start() const { return start_; }
+
+        double elapsedMs() const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+        }
+
+        bool expired() const { return budget_ms_ > 0.0 && elapsedMs() > budget_ms_; }
+    };
+}
+
+#endif // FRAME_DEADLINE_H
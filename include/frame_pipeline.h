@@ -0,0 +1,124 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <opencv2/opencv.hpp>
+#include <dlib/image_processing.h>
+#include "driver_state.h"
+#include "head_pose_detector.h"
+#include "face_landmarks.h"
+#include "blink_detector.h"
+
+namespace DrowsinessDetector
+{
+    // Output of the inference stage for one frame, consumed by the render/log stage
+    struct FrameResult
+    {
+        double timestamp_ms = 0.0; // Presentation time of the analysed frame
+        bool face_detected = false;
+        cv::Rect face_rect;
+        double ear = 0.0;
+        double mar = 0.0;
+        DriverState state = DriverState::NO_FACE_DETECTED;
+        HeadPose head_pose;
+        FaceLandmarks landmarks;
+
+        // Tracker timers sampled at inference time, so rendering never touches the tracker
+        double eyes_closed_duration = 0.0;
+        double distraction_duration = 0.0;
+        bool timers_active = false; // Eye-closure or distraction timer running
+        double perclos = -1.0;      // Share of the PERCLOS window with eyes closed, -1 when disabled
+
+        // Blink detection (Config::enable_blink_detection)
+        bool blink_ended = false;     // A blink finished on this frame
+        double blink_duration = 0.0;  // Its duration in seconds
+        BlinkStats blink_stats;
+
+        // Frame budget bookkeeping: when processing began and whether pose was shed
+        std::chrono::steady_clock::time_point processing_start = std::chrono::steady_clock::now();
+        bool pose_skipped = false;
+    };
+
+    // One preallocated slot circulating between the pipeline stages
+    struct FramePacket
+    {
+        cv::Mat frame;
+        long long index = 0;
+        double timestamp_ms = 0.0;
+        FrameResult result;
+    };
+
+    /**
+     * @brief Fixed-capacity blocking FIFO connecting two pipeline stages
+     *
+     * Storage is allocated once in the constructor; push blocks while full and
+     * pop blocks while empty. close() wakes every waiter: push then fails and
+     * pop drains the remaining items before failing.
+     */
+    template <typename T>
+    class BoundedQueue
+    {
+    private:
+        std::vector<T> buffer_;
+        size_t head_ = 0;
+        size_t count_ = 0;
+        bool closed_ = false;
+        std::mutex mutex_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+
+    public:
+        explicit BoundedQueue(size_t capacity) : buffer_(capacity > 0 ? capacity : 1) {}
+
+        bool push(T item)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_full_.wait(lock, [this]
+                           { return closed_ || count_ < buffer_.size(); });
+            if (closed_)
+                return false;
+
+            buffer_[(head_ + count_) % buffer_.size()] = std::move(item);
+            ++count_;
+            lock.unlock();
+            not_empty_.notify_one();
+            return true;
+        }
+
+        bool pop(T &item)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [this]
+                            { return closed_ || count_ > 0; });
+            if (count_ == 0)
+                return false;
+
+            item = std::move(buffer_[head_]);
+            head_ = (head_ + 1) % buffer_.size();
+            --count_;
+            lock.unlock();
+            not_full_.notify_one();
+            return true;
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed_ = true;
+            }
+            not_empty_.notify_all();
+            not_full_.notify_all();
+        }
+
+        size_t capacity() const { return buffer_.size(); }
+
+        BoundedQueue(const BoundedQueue &) = delete;
+        BoundedQueue &operator=(const BoundedQueue &) = delete;
+    };
+}
+
+#endif // FRAME_PIPELINE_H
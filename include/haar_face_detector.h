@@ -0,0 +1,31 @@
+#ifndef HAAR_FACE_DETECTOR_H
+#define HAAR_FACE_DETECTOR_H
+
+#include "face_detector.h"
+
+namespace DrowsinessDetector
+{
+    // OpenCV Haar cascade backend; runs on a grayscale copy of the image
+    class HaarFaceDetector : public FaceDetector
+    {
+    private:
+        cv::CascadeClassifier cascade_;
+        double scale_factor_ = 1.1;
+        int min_neighbors_ = 5;
+        int min_face_size_ = 0;
+        FaceBoxCalibration calibration_;
+        cv::Mat gray_buffer_;
+        std::vector<cv::Rect> faces_buffer_;
+
+    public:
+        explicit HaarFaceDetector(const Config &config = Config());
+
+        // Loads the cascade XML; false if it is missing or invalid
+        bool initialize(const std::string &cascade_path);
+
+        std::vector<dlib::rectangle> detect(const cv::Mat &image) override;
+        std::string getName() const override { return "haar"; }
+    };
+}
+
+#endif // HAAR_FACE_DETECTOR_H
@@ -6,6 +6,7 @@
 #include <dlib/image_processing/frontal_face_detector.h>
 #include <dlib/image_processing.h>
 #include <vector>
+#include "face_landmarks.h"
 
 namespace DrowsinessDetector
 {
@@ -35,6 +36,9 @@ namespace DrowsinessDetector
     private:
         // 3D model points for facial landmarks (in mm, relative to nose tip)
         std::vector<cv::Point3f> model_points_;
+
+        // 2D points matching model_points_, refilled every frame without reallocating
+        std::vector<cv::Point2f> image_points_;
         
         // Camera matrix and distortion coefficients
         cv::Mat camera_matrix_;
@@ -54,14 +58,14 @@ namespace DrowsinessDetector
         void initializeModelPoints();
         void initializeCameraMatrix(int img_width, int img_height);
         HeadDirection classifyHeadDirection(double pitch, double yaw) const;
-        std::vector<cv::Point2f> extractHeadPosePoints(const dlib::full_object_detection& landmarks) const;
+        void extractHeadPosePoints(const FaceLandmarks& landmarks, std::vector<cv::Point2f>& points) const;
 
     public:
         HeadPoseDetector();
         ~HeadPoseDetector() = default;
 
         bool initialize(int img_width, int img_height);
-        HeadPose estimatePose(const dlib::full_object_detection& landmarks, int img_width, int img_height);
+        HeadPose estimatePose(const FaceLandmarks& landmarks, int img_width, int img_height);
         
         // Utility methods
         static std::string headDirectionToString(HeadDirection direction);
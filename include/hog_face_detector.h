@@ -0,0 +1,87 @@
+#ifndef HOG_FACE_DETECTOR_H
+#define HOG_FACE_DETECTOR_H
+
+#include <vector>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include <dlib/opencv.h>
+#include <dlib/image_processing/frontal_face_detector.h>
+#include <dlib/image_processing.h>
+#include "config.h"
+#include "face_detector.h"
+#include "thread_pool.h"
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief dlib's frontal-face HOG detector with an in-cabin pyramid
+     *
+     * Loads the same frontal-face weights as get_frontal_face_detector() but
+     * rebuilds the scan_fhog_pyramid with Config::hog_pyramid_downsample and
+     * Config::hog_max_pyramid_levels. With the defaults the stock detector is
+     * used unchanged.
+     *
+     * With Config::hog_threads != 1 the pyramid levels are built and scanned in
+     * parallel on a private pool, then merged with the model's own overlap test,
+     * so the latency of a single frame drops. Modes that run several detectors
+     * at once size these pools with threadsPerDetector() so they share the cores.
+     */
+    class HogFaceDetector : public FaceDetector
+    {
+    private:
+        // Type-erased object_detector<scan_fhog_pyramid<pyramid_down<N>>>
+        class Pyramid
+        {
+        public:
+            virtual ~Pyramid() = default;
+            virtual std::vector<dlib::rectangle> detect(const cv::Mat &image) = 0;
+
+            // Scans only the given image (no pyramid), scores kept for merging
+            virtual void detectLevel(const cv::Mat &level, std::vector<dlib::rect_detection> &detections) = 0;
+
+            // Copy of this detector that scans a single pyramid level
+            virtual std::unique_ptr<Pyramid> makeSingleLevel() const = 0;
+
+            virtual double levelRatio() const = 0; // Size of each level relative to the previous
+            virtual unsigned long maxLevels() const = 0;
+            virtual cv::Size minLevelSize() const = 0;
+            virtual const dlib::test_box_overlap &overlapTester() const = 0;
+        };
+
+        template <unsigned long N>
+        class PyramidDetector;
+
+        template <unsigned long N>
+        static std::unique_ptr<Pyramid> makePyramid(const dlib::frontal_face_detector &base, int max_levels);
+
+        std::unique_ptr<Pyramid> pyramid_;
+        long window_size_ = 80;
+        int min_face_size_ = 0;
+
+        // Parallel level scanning: one single-level detector and result slot per level
+        std::unique_ptr<ThreadPool> pool_;
+        std::vector<std::unique_ptr<Pyramid>> level_detectors_;
+        std::vector<std::vector<dlib::rect_detection>> level_detections_;
+
+        std::vector<dlib::rectangle> detectParallel(const cv::Mat &image);
+
+    public:
+        explicit HogFaceDetector(const Config &config = Config());
+        ~HogFaceDetector() override;
+
+        std::vector<dlib::rectangle> detect(const cv::Mat &image) override;
+        std::string getName() const override { return "hog"; }
+
+        // Side of the square detection window, the smallest face a single scan can find
+        long getWindowSize() const { return window_size_; }
+
+        // Largest pre-scale that still finds every face of Config::hog_min_face_size pixels (1.0 when unset)
+        double getMinFaceScale() const override;
+
+        // hog_threads for each of `detectors` detectors running concurrently: 0 (all cores) becomes an
+        // equal share of the cores and an explicit count is capped to that share, at least 1
+        static int threadsPerDetector(int hog_threads, size_t detectors);
+    };
+}
+
+#endif // HOG_FACE_DETECTOR_H
@@ -0,0 +1,48 @@
+#ifndef LANDMARK_PREDICTOR_H
+#define LANDMARK_PREDICTOR_H
+
+#include <memory>
+#include <string>
+#include <opencv2/opencv.hpp>
+#include <dlib/image_processing/full_object_detection.h>
+#include "config.h"
+#include "face_landmarks.h"
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief Landmark regression engine behind FacialLandmarkDetector
+     *
+     * Implementations are immutable after loading, so one instance is shared
+     * read-only by every detector and stream.
+     */
+    class LandmarkPredictor
+    {
+    public:
+        virtual ~LandmarkPredictor() = default;
+
+        // Accepts BGR or 8-bit grayscale frames; fills landmarks in frame coordinates
+        virtual void predict(const cv::Mat &frame, const dlib::rectangle &face, FaceLandmarks &landmarks) const = 0;
+
+        virtual std::string getName() const = 0;
+        virtual size_t getNumParts() const = 0;
+
+        // Warm start: refine a starting shape (e.g. the previous frame's landmarks) with only
+        // the last `levels` cascade levels. Engines without it always run the full cascade
+        virtual bool supportsWarmStart() const { return false; }
+        virtual size_t getCascadeLevels() const { return 0; }
+        virtual void predictFrom(const cv::Mat &frame, const dlib::rectangle &face, const FaceLandmarks &start,
+                                 size_t levels, FaceLandmarks &landmarks) const
+        {
+            (void)start;
+            (void)levels;
+            predict(frame, face, landmarks);
+        }
+
+        // Loads Config::model_path with the engine selected by Config::use_flat_shape_predictor; nullptr on
+        // failure, including a model whose part count differs from LandmarkLayout::POINTS
+        static std::shared_ptr<const LandmarkPredictor> load(const Config &config);
+    };
+}
+
+#endif // LANDMARK_PREDICTOR_H
@@ -0,0 +1,70 @@
+#ifndef LATEST_FRAME_GRABBER_H
+#define LATEST_FRAME_GRABBER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <opencv2/opencv.hpp>
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief Keeps only the newest frame of a capture source
+     *
+     * A dedicated thread reads the source continuously and overwrites a single
+     * "latest" slot; the consumer always takes the most recent frame, so the
+     * glass-to-alert latency stays bounded when inference is slower than the
+     * camera. Frames overwritten before they were taken are counted as dropped.
+     * Buffers are swapped, never copied, between the grabber and the consumer.
+     */
+    class LatestFrameGrabber
+    {
+    private:
+        cv::VideoCapture &capture_;
+        std::thread grab_thread_;
+        mutable std::mutex mutex_;
+        std::condition_variable frame_ready_;
+
+        cv::Mat back_buffer_;   // Written by the grabber thread only
+        cv::Mat latest_frame_;  // Guarded by mutex_
+        double latest_timestamp_ms_ = 0.0;
+        bool has_new_frame_ = false;
+        bool end_of_stream_ = false;
+        std::atomic<bool> should_stop_{false};
+        double pace_fps_ = 0.0;
+
+        // Statistics
+        std::atomic<size_t> frames_grabbed_{0};
+        std::atomic<size_t> frames_dropped_{0};
+        std::atomic<size_t> frames_delivered_{0};
+
+        void grabLoop();
+
+    public:
+        explicit LatestFrameGrabber(cv::VideoCapture &capture);
+        ~LatestFrameGrabber();
+
+        /**
+         * @brief Start the grabber thread
+         * @param pace_fps Read rate for sources that do not block (video files); 0 reads as fast as the source allows
+         */
+        void start(double pace_fps = 0.0);
+
+        /**
+         * @brief Take the newest frame not yet delivered, waiting for one if needed
+         * @param timestamp_ms Receives the frame's CAP_PROP_POS_MSEC sampled right after it was read
+         * @return false once the source is exhausted or the grabber was stopped
+         */
+        bool takeLatest(cv::Mat &frame, double &timestamp_ms);
+
+        void stop();
+
+        void getStats(size_t &grabbed, size_t &dropped, size_t &delivered) const;
+
+        LatestFrameGrabber(const LatestFrameGrabber &) = delete;
+        LatestFrameGrabber &operator=(const LatestFrameGrabber &) = delete;
+    };
+}
+
+#endif // LATEST_FRAME_GRABBER_H
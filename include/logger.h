@@ -16,6 +16,17 @@
 
 namespace DrowsinessDetector
 {
+    // Optional per-event context carried alongside the core measurements
+    struct LogMetadata
+    {
+        double media_time_ms = -1.0; // Presentation time of the frame in the source video, -1 when unknown
+        std::string stream_id;       // Source stream in multi-stream mode, empty for a single stream
+        double perclos = -1.0;       // PERCLOS in [0, 1], -1 when disabled
+        bool has_blink_stats = false; // blink_stats is filled (blink detection enabled)
+        BlinkStats blink_stats;
+        double blink_duration = -1.0; // Seconds of a blink that ended on this frame, -1 when none
+    };
+
     struct LogEntry
     {
         std::chrono::system_clock::time_point timestamp;
@@ -25,6 +36,7 @@ namespace DrowsinessDetector
         double mar_value;
         double head_yaw = 0.0;
         std::string image_filename;
+        LogMetadata metadata;
         LogEntry(DriverState s, const std::string &msg, double ear, double mar, double yaw, const std::string &img = "");
         LogEntry(DriverState s, const std::string &msg, double ear, double mar, const std::string &img = "");
     };
@@ -41,7 +53,7 @@ namespace DrowsinessDetector
 
         // Statistics
         size_t total_events_logged_;
-        size_t images_saved_;
+        std::atomic<size_t> images_saved_;
 
         // Instance members
         std::queue<LogEntry> log_queue_;
@@ -72,10 +84,10 @@ namespace DrowsinessDetector
 
         // with head pose enabled
         static void log(DriverState state, const std::string &message, double ear, double mar,
-                        double head_yaw, const cv::Mat &frame);
+                        double head_yaw, const cv::Mat &frame, const LogMetadata &metadata = LogMetadata());
 
         static void log(DriverState state, const std::string &message,
-                        double ear, double mar, const cv::Mat &frame);
+                        double ear, double mar, const cv::Mat &frame, const LogMetadata &metadata = LogMetadata());
 
         // Get publishing statistics
         void getStats(size_t &events_logged, size_t &images_saved,
@@ -93,14 +105,14 @@ namespace DrowsinessDetector
         void shutdownImpl();
         // with head pose enabled
         void logImpl(DriverState state, const std::string &message, double ear, double mar,
-                     double head_yaw, const cv::Mat &frame);
+                     double head_yaw, const cv::Mat &frame, const LogMetadata &metadata);
 
         void logImpl(DriverState state, const std::string &message, double ear, double mar,
-                     const cv::Mat &frame);
+                     const cv::Mat &frame, const LogMetadata &metadata);
 
         void setupDirectories();
         std::string GetCurrentTimeStamp();
-        std::string saveSnapshot(const cv::Mat &frame);
+        std::string saveSnapshot(const cv::Mat &frame, const std::string &stream_id);
         void printToConsole(const LogEntry &entry);
         void processLogQueue();
         std::string LogEntryToJsonString(const LogEntry &entry);
@@ -0,0 +1,67 @@
+#ifndef MULTI_STREAM_SERVER_H
+#define MULTI_STREAM_SERVER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "config.h"
+#include "frame_analyzer.h"
+#include "adaptive_rate_controller.h"
+#include "frame_deadline.h"
+#include "thread_pool.h"
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief Monitors many camera/video streams in one process
+     *
+     * Every stream has its own capture, face detector and StateTracker, while the
+     * ~100 MB shape predictor is loaded once and shared read-only. Each stream
+     * keeps exactly one frame task in flight (so its tracker sees frames in
+     * order); the tasks of all streams are scheduled on a work-stealing pool,
+     * so throughput scales with cores instead of with processes. Always headless.
+     */
+    class MultiStreamServer
+    {
+    private:
+        struct Stream
+        {
+            std::string id;
+            std::string source;
+            bool is_file = false;
+            cv::VideoCapture capture;
+            std::unique_ptr<FrameAnalyzer> analyzer;
+            std::unique_ptr<AdaptiveRateController> rate_controller;
+            cv::Mat frame; // Reused by every frame task of this stream
+            long long frame_count = 0;
+            size_t processed_frames = 0;
+        };
+
+        Config config_;
+        std::shared_ptr<const LandmarkPredictor> landmark_predictor_;
+        std::vector<std::unique_ptr<Stream>> streams_;
+        std::unique_ptr<ThreadPool> pool_;
+        std::atomic<size_t> active_streams_{0};
+        std::atomic<bool> should_stop_{false};
+        DeadlineStats deadline_stats_;
+
+        bool openStream(Stream &stream);
+        void processNextFrame(Stream &stream);
+        void logFrameResult(const Stream &stream, const cv::Mat &frame, const FrameResult &result,
+                            const FrameDeadline &deadline);
+
+    public:
+        MultiStreamServer(const Config &config, std::shared_ptr<const LandmarkPredictor> landmark_predictor);
+
+        // Opens every source in config.stream_sources; streams that fail to open are skipped
+        bool initialize();
+
+        // Runs until every stream has ended or stop_requested returns true
+        int run(const std::function<bool()> &stop_requested);
+    };
+}
+
+#endif // MULTI_STREAM_SERVER_H
@@ -0,0 +1,63 @@
+#ifndef PERCLOS_WINDOW_H
+#define PERCLOS_WINDOW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief PERCLOS: share of the last N seconds the eyes were closed
+     *
+     * Each processed frame adds one sample weighted by the time it covers, so
+     * skipped or dropped frames do not bias the ratio. Samples accumulate into
+     * time buckets of window / (nominal frames per window); a ring buffer with
+     * one slot per bucket is sized once from the window and the nominal frame
+     * rate. At or below the nominal rate every frame gets its own bucket, faster
+     * sources share buckets, so the ring always spans the full window. Sums are
+     * kept in integer microseconds: an update is O(1) (amortized over
+     * evictions) with constant memory and no drift.
+     */
+    class PerclosWindow
+    {
+    private:
+        struct Bucket
+        {
+            int64_t duration_us;
+            int64_t closed_us;
+        };
+
+        static constexpr int64_t MAX_SAMPLE_US = 500000; // Longer gaps (no face, stalls) count as 0.5 s
+
+        std::vector<Bucket> buckets_; // Ring buffer, capacity fixed by reset()
+        size_t head_ = 0;             // Oldest bucket
+        size_t size_ = 0;
+        int64_t bucket_us_ = 0;       // The newest bucket takes samples until it covers this much
+        int64_t window_us_ = 0;
+        int64_t total_us_ = 0;
+        int64_t closed_us_ = 0;
+
+        void popOldest();
+
+    public:
+        PerclosWindow() = default;
+        PerclosWindow(double window_seconds, double frame_rate);
+
+        // Clears the window and sizes the buffer for window_seconds * frame_rate buckets
+        void reset(double window_seconds, double frame_rate);
+
+        // One frame covering duration_seconds
+        void add(double duration_seconds, bool eyes_closed);
+
+        // Closed time / covered time in [0, 1]; 0 while empty
+        double getPerclos() const;
+        double getCoveredSeconds() const { return total_us_ / 1e6; }
+        double getWindowSeconds() const { return window_us_ / 1e6; }
+
+        // The buckets span the whole window, so the ratio is not dominated by a short start
+        bool isFull() const { return window_us_ > 0 && total_us_ >= window_us_; }
+    };
+}
+
+#endif // PERCLOS_WINDOW_H
@@ -0,0 +1,77 @@
+#ifndef PRESENCE_GATE_H
+#define PRESENCE_GATE_H
+
+#include <cstddef>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "config.h"
+
+namespace DrowsinessDetector
+{
+    // How often the gate let frames through and whether it ever hid a real face
+    struct PresenceGateStats
+    {
+        size_t checks = 0;          // Frames the gate decided on (no face seen on the previous frame)
+        size_t passed = 0;          // Gate saw a possible face, full detector ran
+        size_t hits = 0;            // ...and the detector found one
+        size_t false_alarms = 0;    // ...and the detector found none
+        size_t rejected = 0;        // Full detector skipped
+        size_t audits = 0;          // Rejected frames checked with the full detector anyway
+        size_t audit_misses = 0;    // Audited frames where the detector did find a face (gate hid it)
+    };
+
+    /**
+     * @brief Low-cost "is anyone there" check in front of the face detector
+     *
+     * Only consulted while no face was seen on the previous frame (empty seat,
+     * driver turned away). CASCADE runs a Haar cascade on a heavily downscaled
+     * grayscale frame; MOTION compares it with the previous one and opens on
+     * enough frame-difference energy; its reference is dropped while a face is
+     * tracked, and the first check without one only takes a new reference. Every Config::presence_gate_audit_interval
+     * rejections, the full detector runs anyway so misses can be counted.
+     */
+    class PresenceGate
+    {
+    private:
+        enum class Pending
+        {
+            NONE,
+            PASSED,
+            AUDIT
+        };
+
+        Config config_;
+        cv::CascadeClassifier cascade_;
+        cv::Mat gray_buffer_;
+        cv::Mat small_buffer_;
+        cv::Mat previous_small_;
+        cv::Mat diff_buffer_;
+        std::vector<cv::Rect> faces_buffer_;
+        bool has_reference_ = false;
+        Pending pending_ = Pending::NONE;
+        size_t rejections_since_audit_ = 0;
+        PresenceGateStats stats_;
+
+        void downscale(const cv::Mat &frame, cv::Mat &small);
+        bool looksOccupied(const cv::Mat &frame);
+
+    public:
+        explicit PresenceGate(const Config &config);
+
+        // Loads the cascade in CASCADE mode; false if it cannot be loaded
+        bool initialize();
+
+        // True when the full detector should run on this frame
+        bool check(const cv::Mat &frame, bool face_on_previous_frame);
+
+        // Drops the MOTION reference frame; called on tracked frames, which the gate never sees
+        void invalidate() { has_reference_ = false; }
+
+        // Outcome of the full detector on a frame check() let through
+        void report(bool face_found);
+
+        const PresenceGateStats &getStats() const { return stats_; }
+    };
+}
+
+#endif // PRESENCE_GATE_H
@@ -0,0 +1,67 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DrowsinessDetector
+{
+    /**
+     * @brief Fixed-size work-stealing thread pool
+     *
+     * Every worker owns a deque: tasks submitted from a worker go to the back of
+     * its own deque and are popped LIFO (cache-warm), while idle workers steal
+     * from the front of other deques. Tasks submitted from outside the pool are
+     * spread round-robin.
+     */
+    class ThreadPool
+    {
+    private:
+        struct WorkerQueue
+        {
+            std::deque<std::function<void()>> tasks;
+            std::mutex mutex;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        std::vector<std::thread> workers_;
+
+        std::mutex wake_mutex_;
+        std::condition_variable wake_;
+        std::condition_variable idle_;
+        size_t queued_tasks_ = 0;     // Guarded by wake_mutex_
+        size_t unfinished_tasks_ = 0; // Guarded by wake_mutex_
+        bool should_stop_ = false;    // Guarded by wake_mutex_
+
+        std::atomic<size_t> next_queue_{0};
+        std::atomic<size_t> tasks_stolen_{0};
+
+        void workerLoop(size_t index);
+        bool popTask(size_t index, std::function<void()> &task);
+        int currentWorkerIndex() const;
+
+    public:
+        // 0 threads selects std::thread::hardware_concurrency()
+        explicit ThreadPool(size_t thread_count = 0);
+        ~ThreadPool();
+
+        void submit(std::function<void()> task);
+
+        // Blocks until every task submitted so far, including tasks they submitted, has finished
+        void waitIdle();
+
+        size_t size() const { return workers_.size(); }
+        size_t tasksStolen() const { return tasks_stolen_; }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+    };
+}
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,38 @@
+#ifndef YUNET_FACE_DETECTOR_H
+#define YUNET_FACE_DETECTOR_H
+
+#include "face_detector.h"
+
+// cv::FaceDetectorYN first shipped in OpenCV 4.5.4
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && (CV_VERSION_MINOR > 5 || (CV_VERSION_MINOR == 5 && CV_VERSION_REVISION >= 4)))
+#define DROWSINESS_HAVE_YUNET 1
+#include <opencv2/objdetect/face.hpp>
+#endif
+
+namespace DrowsinessDetector
+{
+#ifdef DROWSINESS_HAVE_YUNET
+    // OpenCV DNN YuNet backend, loaded from a local ONNX model
+    class YuNetFaceDetector : public FaceDetector
+    {
+    private:
+        cv::Ptr<cv::FaceDetectorYN> detector_;
+        float score_threshold_ = 0.9f;
+        FaceBoxCalibration calibration_;
+        cv::Size input_size_;
+        cv::Mat bgr_buffer_;
+        cv::Mat faces_buffer_;
+
+    public:
+        explicit YuNetFaceDetector(const Config &config = Config());
+
+        // Loads the ONNX model; false if it is missing or OpenCV cannot parse it
+        bool initialize(const std::string &model_path);
+
+        std::vector<dlib::rectangle> detect(const cv::Mat &image) override;
+        std::string getName() const override { return "yunet"; }
+    };
+#endif
+}
+
+#endif // YUNET_FACE_DETECTOR_H
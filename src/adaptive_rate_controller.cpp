@@ -0,0 +1,57 @@
+#include "../include/adaptive_rate_controller.h"
+#include <algorithm>
+#include <cmath>
+
+namespace DrowsinessDetector
+{
+    namespace
+    {
+        constexpr double PROCESSING_EMA_ALPHA = 0.1;
+        constexpr double DEFAULT_SOURCE_FPS = 30.0;
+    }
+
+    AdaptiveRateController::AdaptiveRateController(const Config &config)
+    {
+        this->config_ = config;
+    }
+
+    void AdaptiveRateController::setSourceFps(double fps)
+    {
+        // Cameras frequently report 0 fps
+        frame_interval_ms_ = 1000.0 / (fps > 0.0 ? fps : DEFAULT_SOURCE_FPS);
+    }
+
+    bool AdaptiveRateController::isClearlyAlert(const FrameResult &result) const
+    {
+        if (!result.face_detected || result.timers_active)
+            return false;
+
+        bool ear_far = result.ear > config_.ear_threshold * (1.0 + config_.adaptive_ear_margin);
+        bool mar_far = result.mar < config_.mar_threshold * (1.0 - config_.adaptive_mar_margin);
+        bool head_forward = !result.head_pose.is_valid || result.head_pose.direction == HeadDirection::FORWARD;
+        return ear_far && mar_far && head_forward;
+    }
+
+    void AdaptiveRateController::update(const FrameResult &result, double processing_ms)
+    {
+        avg_processing_ms_ = avg_processing_ms_ == 0.0
+                                 ? processing_ms
+                                 : avg_processing_ms_ + PROCESSING_EMA_ALPHA * (processing_ms - avg_processing_ms_);
+
+        if (!isClearlyAlert(result))
+        {
+            // Anything that could become an alert gets full rate immediately
+            relaxed_streak_ = 0;
+            stride_ = 1;
+            return;
+        }
+
+        if (++relaxed_streak_ < config_.adaptive_relax_frames)
+            return;
+
+        // Smallest stride whose inference load stays within the budget share of one core
+        double budget_ms = std::max(config_.adaptive_cpu_budget, 0.01) * frame_interval_ms_;
+        int budget_stride = static_cast<int>(std::ceil(avg_processing_ms_ / budget_ms));
+        stride_ = std::clamp(budget_stride, 1, std::max(1, config_.adaptive_max_stride));
+    }
+}
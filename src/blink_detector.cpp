@@ -0,0 +1,127 @@
+#include "../include/blink_detector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace DrowsinessDetector
+{
+    BlinkDetector::BlinkDetector(const Config &config)
+    {
+        configure(config);
+    }
+
+    void BlinkDetector::configure(const Config &config)
+    {
+        close_threshold_ = config.ear_threshold;
+        open_threshold_ = config.ear_threshold + std::max(0.0, config.blink_hysteresis);
+        min_duration_us_ = static_cast<int64_t>(std::llround(std::max(0.0, config.blink_min_seconds) * 1e6));
+        max_duration_us_ = std::max(min_duration_us_ + 1, static_cast<int64_t>(std::llround(config.blink_max_seconds * 1e6)));
+        window_ = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(std::max(1.0, config.blink_window_seconds)));
+
+        eyes_closed_ = false;
+        head_ = 0;
+        size_ = 0;
+        histogram_.fill(0);
+        duration_sum_us_ = 0;
+        total_blinks_ = 0;
+        started_ = false;
+    }
+
+    void BlinkDetector::push(const Blink &blink)
+    {
+        // Saturated window: the oldest blink leaves early
+        if (size_ == MAX_WINDOW_BLINKS)
+            popOldest();
+
+        blinks_[(head_ + size_) % MAX_WINDOW_BLINKS] = blink;
+        size_++;
+        histogram_[blink.bin]++;
+        duration_sum_us_ += blink.duration_us;
+    }
+
+    void BlinkDetector::popOldest()
+    {
+        const Blink &oldest = blinks_[head_];
+        histogram_[oldest.bin]--;
+        duration_sum_us_ -= oldest.duration_us;
+        head_ = (head_ + 1) % MAX_WINDOW_BLINKS;
+        size_--;
+    }
+
+    void BlinkDetector::evictBefore(Clock::time_point cutoff)
+    {
+        while (size_ > 0 && blinks_[head_].end < cutoff)
+            popOldest();
+    }
+
+    bool BlinkDetector::update(double ear, Clock::time_point now, BlinkEvent &event)
+    {
+        if (!started_)
+        {
+            started_ = true;
+            first_update_ = now;
+        }
+        last_update_ = now;
+        evictBefore(now - window_);
+
+        if (!eyes_closed_)
+        {
+            if (ear < close_threshold_)
+            {
+                eyes_closed_ = true;
+                closed_since_ = now;
+            }
+            return false;
+        }
+
+        // Between the two thresholds the eyes stay closed
+        if (ear <= open_threshold_)
+            return false;
+
+        eyes_closed_ = false;
+        const int64_t duration_us = std::chrono::duration_cast<std::chrono::microseconds>(now - closed_since_).count();
+        if (duration_us < min_duration_us_ || duration_us > max_duration_us_)
+            return false;
+
+        const size_t bin = std::min(HISTOGRAM_BINS - 1,
+                                    static_cast<size_t>(duration_us * static_cast<int64_t>(HISTOGRAM_BINS) / max_duration_us_));
+        push(Blink{now, duration_us, bin});
+        total_blinks_++;
+
+        event.end = now;
+        event.duration_seconds = duration_us / 1e6;
+        return true;
+    }
+
+    BlinkStats BlinkDetector::getStats() const
+    {
+        BlinkStats stats;
+        stats.total_blinks = total_blinks_;
+        stats.window_blinks = size_;
+        if (!started_)
+            return stats;
+
+        // Until a full window has passed the rate covers the time observed so far
+        const double observed = std::chrono::duration<double>(std::min(last_update_ - first_update_, window_)).count();
+        if (observed >= 1.0)
+            stats.rate_per_minute = size_ * 60.0 / observed;
+
+        if (size_ == 0)
+            return stats;
+        stats.mean_duration = static_cast<double>(duration_sum_us_) / size_ / 1e6;
+
+        // Smallest bin at which 95% of the window's blinks are accounted for; report its upper edge
+        const size_t target = static_cast<size_t>(std::ceil(0.95 * size_));
+        size_t cumulative = 0;
+        for (size_t bin = 0; bin < HISTOGRAM_BINS; ++bin)
+        {
+            cumulative += histogram_[bin];
+            if (cumulative >= target)
+            {
+                stats.p95_duration = (bin + 1) * (max_duration_us_ / 1e6) / HISTOGRAM_BINS;
+                break;
+            }
+        }
+        return stats;
+    }
+}
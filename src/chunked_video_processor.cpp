@@ -0,0 +1,162 @@
+#include "../include/chunked_video_processor.h"
+#include "../include/frame_analyzer.h"
+#include "../include/hog_face_detector.h"
+#include "../include/logger.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <opencv2/opencv.hpp>
+
+namespace DrowsinessDetector
+{
+    ChunkedVideoProcessor::ChunkedVideoProcessor(const Config &config,
+                                                 std::shared_ptr<const LandmarkPredictor> landmark_predictor)
+    {
+        this->config_ = config;
+        this->landmark_predictor_ = std::move(landmark_predictor);
+    }
+
+    int ChunkedVideoProcessor::run()
+    {
+        cv::VideoCapture probe(config_.video_path);
+        if (!probe.isOpened())
+        {
+            std::cerr << "ChunkedVideoProcessor: Failed to open " << config_.video_path << std::endl;
+            return -1;
+        }
+        const long long total_frames = static_cast<long long>(probe.get(cv::CAP_PROP_FRAME_COUNT));
+        const double fps = probe.get(cv::CAP_PROP_FPS);
+        probe.release();
+
+        if (total_frames <= 0 || fps <= 0.0)
+        {
+            std::cerr << "ChunkedVideoProcessor: Source has no frame count/fps, cannot split into chunks" << std::endl;
+            return -1;
+        }
+
+        // The overlap must cover the longest timer and sliding window, otherwise a closure running
+        // across a boundary would start counting from zero in the next chunk and PERCLOS/blink
+        // statistics would only be valid a full window into it
+        const double warmup_seconds = std::max({config_.chunk_warmup_seconds,
+                                                config_.drowsy_time_seconds,
+                                                config_.distraction_time_seconds,
+                                                config_.enable_perclos ? config_.perclos_window_seconds : 0.0,
+                                                config_.enable_blink_detection ? config_.blink_window_seconds : 0.0});
+        const long long warmup_frames = static_cast<long long>(std::ceil(warmup_seconds * fps));
+        const int workers = static_cast<int>(std::min<long long>(std::max(1, config_.offline_workers), total_frames));
+
+        std::vector<ChunkRange> ranges(workers);
+        for (int i = 0; i < workers; ++i)
+        {
+            ranges[i].index = i;
+            ranges[i].first_frame = total_frames * i / workers;
+            ranges[i].end_frame = total_frames * (i + 1) / workers;
+            ranges[i].warmup_frame = std::max(0LL, ranges[i].first_frame - warmup_frames);
+        }
+
+        std::cout << "Chunked processing: " << total_frames << " frames in " << workers
+                  << " chunks, " << warmup_seconds << "s warm-up" << std::endl;
+
+        // Every chunk has its own HOG pool; together they share the cores
+        Config analyzer_config = config_;
+        analyzer_config.hog_threads = HogFaceDetector::threadsPerDetector(config_.hog_threads, static_cast<size_t>(workers));
+
+        std::vector<ChunkOutput> outputs(workers);
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+        for (int i = 0; i < workers; ++i)
+        {
+            threads.emplace_back(&ChunkedVideoProcessor::processChunk, this, std::cref(ranges[i]), std::cref(analyzer_config),
+                                 std::ref(outputs[i]));
+        }
+        for (auto &thread : threads)
+            thread.join();
+
+        // Merge per-chunk logs in timestamp order
+        std::vector<ChunkEvent> merged;
+        size_t processed_frames = 0;
+        for (const auto &output : outputs)
+        {
+            if (!output.ok)
+            {
+                std::cerr << "ChunkedVideoProcessor: A chunk failed, results are incomplete" << std::endl;
+            }
+            merged.insert(merged.end(), output.events.begin(), output.events.end());
+            processed_frames += output.processed_frames;
+        }
+        std::stable_sort(merged.begin(), merged.end(),
+                         [](const ChunkEvent &a, const ChunkEvent &b)
+                         {
+                             return a.media_time_ms < b.media_time_ms;
+                         });
+
+        // Frames are not retained across the merge, so no snapshots are written in this mode
+        const cv::Mat no_snapshot;
+        for (const auto &event : merged)
+        {
+            LogMetadata metadata;
+            metadata.media_time_ms = event.media_time_ms;
+            metadata.perclos = event.perclos;
+            metadata.has_blink_stats = config_.enable_blink_detection;
+            metadata.blink_stats = event.blink_stats;
+            metadata.blink_duration = event.blink_duration;
+            config_.enable_head_pose_detection ? Logger::log(event.state, event.message, event.ear, event.mar, event.head_yaw, no_snapshot, metadata) : Logger::log(event.state, event.message, event.ear, event.mar, no_snapshot, metadata);
+        }
+
+        std::cout << "Total Processed Frames: " << processed_frames << " | Events: " << merged.size() << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    void ChunkedVideoProcessor::processChunk(const ChunkRange &range, const Config &analyzer_config, ChunkOutput &output)
+    {
+        FrameAnalyzer analyzer(analyzer_config);
+        if (!analyzer.initialize(landmark_predictor_))
+            return;
+        analyzer.setUseEventTime(true);
+
+        cv::VideoCapture cap(config_.video_path);
+        if (!cap.isOpened())
+            return;
+        if (range.warmup_frame > 0)
+            cap.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(range.warmup_frame));
+
+        cv::Mat frame;
+        for (long long frame_index = range.warmup_frame; frame_index < range.end_frame; ++frame_index)
+        {
+            // Skip on the global frame number so chunks process exactly the frames a sequential run would;
+            // skipped frames are only demuxed, never decoded
+            if ((frame_index + 1) % config_.frame_skip != 0)
+            {
+                if (!cap.grab())
+                    break;
+                continue;
+            }
+
+            if (!cap.read(frame) || frame.empty())
+                break;
+
+            FrameResult result = analyzer.analyze(frame, cap.get(cv::CAP_PROP_POS_MSEC));
+            if (frame_index < range.first_frame)
+                continue; // Warm-up: update timers only
+
+            output.processed_frames++;
+            if (!FrameAnalyzer::shouldLog(result))
+                continue;
+
+            ChunkEvent event;
+            event.media_time_ms = result.timestamp_ms;
+            event.state = result.face_detected ? result.state : DriverState::NO_FACE_DETECTED;
+            event.ear = result.ear;
+            event.mar = result.mar;
+            event.head_yaw = result.head_pose.yaw;
+            event.perclos = result.perclos;
+            event.blink_stats = result.blink_stats;
+            if (result.blink_ended)
+                event.blink_duration = result.blink_duration;
+            event.message = FrameAnalyzer::generateLogMessage(result);
+            output.events.push_back(event);
+        }
+        output.ok = true;
+    }
+}
@@ -7,31 +7,6 @@ namespace DrowsinessDetector
 {
     namespace CVUtils
     {
-        double calculateEAR(const std::vector<cv::Point2f> &eye_points)
-        {
-            if (eye_points.size() != 6)
-                return 0.0;
-
-            double vertical1 = cv::norm(eye_points[1] - eye_points[5]);
-            double vertical2 = cv::norm(eye_points[2] - eye_points[4]);
-            double horizontal = cv::norm(eye_points[0] - eye_points[3]);
-
-            return (horizontal < Constants::EPSILON) ? 0.0 : (vertical1 + vertical2) / (2.0 * horizontal);
-        }
-
-        double calculateMAR(const std::vector<cv::Point2f> &mouth_points)
-        {
-            if (mouth_points.size() != 8)
-                return 0.0;
-
-            double vertical1 = cv::norm(mouth_points[3] - mouth_points[7]);
-            double vertical2 = cv::norm(mouth_points[2] - mouth_points[6]);
-            double vertical3 = cv::norm(mouth_points[1] - mouth_points[5]);
-            double horizontal = cv::norm(mouth_points[0] - mouth_points[4]);
-
-            return (horizontal < Constants::EPSILON) ? 0.0 : (vertical1 + vertical2 + vertical3) / (2.0 * horizontal);
-        }
-
         cv::Scalar getStateColor(DriverState state, const Config &config)
         {
             switch (state)
@@ -59,5 +34,32 @@ namespace DrowsinessDetector
             oss << std::fixed << std::setprecision(precision) << value;
             return oss.str();
         }
+
+        bool readNextProcessedFrame(cv::VideoCapture &cap, cv::Mat &frame, long long &frame_count,
+                                    int frame_skip, bool seek)
+        {
+            const long long skip = frame_skip > 1 ? frame_skip : 1;
+            const long long next_processed = (frame_count / skip + 1) * skip;
+
+            if (seek && next_processed - 1 > frame_count)
+            {
+                // CAP_PROP_POS_FRAMES is the 0-based index of the next frame to decode
+                if (cap.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(next_processed - 1)))
+                    frame_count = next_processed - 1;
+            }
+
+            // grab() demuxes and advances without the decode/colour conversion of retrieve()
+            while (frame_count + 1 < next_processed)
+            {
+                if (!cap.grab())
+                    return false;
+                ++frame_count;
+            }
+
+            if (!cap.read(frame) || frame.empty())
+                return false;
+            ++frame_count;
+            return true;
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "../include/dlib_landmark_predictor.h"
+#include <dlib/opencv.h>
+#include <iostream>
+
+namespace DrowsinessDetector
+{
+    bool DlibLandmarkPredictor::load(const std::string &model_path)
+    {
+        try
+        {
+            dlib::deserialize(model_path) >> predictor_;
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to load shape predictor: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    void DlibLandmarkPredictor::predict(const cv::Mat &frame, const dlib::rectangle &face, FaceLandmarks &landmarks) const
+    {
+        // dlib returns its parts in a heap vector; copied into the fixed arrays
+        if (frame.channels() == 1)
+            landmarks.assign(predictor_(dlib::cv_image<unsigned char>(frame), face));
+        else
+            landmarks.assign(predictor_(dlib::cv_image<dlib::bgr_pixel>(frame), face));
+    }
+}
@@ -4,6 +4,7 @@ namespace DrowsinessDetector
 {
     DriverState StateTracker::updateState(double ear, double mar, const HeadPose &head_pose, const Config &config)
     {
+        updateBlinks(ear, config);
         bool is_drowsy = checkDrowsiness(ear, config);
         bool is_yawning = checkYawning(mar, config);
         DriverState current_state;
@@ -22,6 +23,7 @@ namespace DrowsinessDetector
 
     DriverState StateTracker::updateState(double ear, double mar, const Config &config)
     {
+        updateBlinks(ear, config);
         bool is_drowsy = checkDrowsiness(ear, config);
         bool is_yawning = checkYawning(mar, config);
         DriverState current_state = getCurrentDriverState(is_drowsy, is_yawning);
@@ -78,11 +80,24 @@ namespace DrowsinessDetector
         }
     }
 
+    void StateTracker::setFrameTimestamp(double timestamp_ms)
+    {
+        use_event_time_ = true;
+        event_time_ = std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double, std::milli>(timestamp_ms)));
+    }
+
+    std::chrono::steady_clock::time_point StateTracker::now() const
+    {
+        return use_event_time_ ? event_time_ : std::chrono::steady_clock::now();
+    }
+
     double StateTracker::getDistractionDuration() const
     {
         if (!distraction_timer_active_)
             return 0.0;
-        auto elapsed = std::chrono::steady_clock::now() - distraction_start_;
+        auto elapsed = now() - distraction_start_;
         return std::chrono::duration<double>(elapsed).count();
     }
 
@@ -90,29 +105,69 @@ namespace DrowsinessDetector
     {
         if (!eyes_closed_timer_active_)
             return 0.0;
-        auto elapsed = std::chrono::steady_clock::now() - eyes_closed_start_;
+        auto elapsed = now() - eyes_closed_start_;
         return std::chrono::duration<double>(elapsed).count();
     }
 
     bool StateTracker::checkDrowsiness(double ear, const Config &config)
     {
-        if (ear < config.ear_threshold)
+        const bool eyes_closed = ear < config.ear_threshold;
+        const bool perclos_drowsy = config.enable_perclos && checkPerclos(eyes_closed, config);
+
+        // Continuous closure: any open-eye frame restarts the timer
+        bool closed_too_long = false;
+        if (eyes_closed)
         {
             if (!eyes_closed_timer_active_)
             {
-                eyes_closed_start_ = std::chrono::steady_clock::now();
+                eyes_closed_start_ = now();
                 eyes_closed_timer_active_ = true;
-                return false;
             }
-
-            auto elapsed = std::chrono::steady_clock::now() - eyes_closed_start_;
-            return std::chrono::duration<double>(elapsed).count() >= config.drowsy_time_seconds;
+            else
+            {
+                auto elapsed = now() - eyes_closed_start_;
+                closed_too_long = std::chrono::duration<double>(elapsed).count() >= config.drowsy_time_seconds;
+            }
         }
         else
         {
             eyes_closed_timer_active_ = false;
-            return false;
         }
+        return closed_too_long || perclos_drowsy;
+    }
+
+    bool StateTracker::checkPerclos(bool eyes_closed, const Config &config)
+    {
+        const double nominal_interval = 1.0 / (config.perclos_frame_rate > 0.0 ? config.perclos_frame_rate : 30.0);
+        if (!perclos_configured_)
+        {
+            perclos_.reset(config.perclos_window_seconds, config.perclos_frame_rate);
+            perclos_configured_ = true;
+        }
+
+        const auto current = now();
+        const double interval = have_perclos_sample_
+                                    ? std::chrono::duration<double>(current - last_perclos_sample_).count()
+                                    : nominal_interval;
+        last_perclos_sample_ = current;
+        have_perclos_sample_ = true;
+
+        perclos_.add(interval, eyes_closed);
+        return perclos_.isFull() && perclos_.getPerclos() >= config.perclos_threshold;
+    }
+
+    void StateTracker::updateBlinks(double ear, const Config &config)
+    {
+        blink_ended_ = false;
+        if (!config.enable_blink_detection)
+            return;
+
+        if (!blink_detector_configured_)
+        {
+            blink_detector_.configure(config);
+            blink_detector_configured_ = true;
+        }
+        blink_ended_ = blink_detector_.update(ear, now(), last_blink_);
     }
 
     bool StateTracker::checkYawning(double mar, const Config &config)
@@ -135,12 +190,12 @@ namespace DrowsinessDetector
         {
             if (!distraction_timer_active_)
             {
-                distraction_start_ = std::chrono::steady_clock::now();
+                distraction_start_ = now();
                 distraction_timer_active_ = true;
                 return false;
             }
 
-            auto elapsed = std::chrono::steady_clock::now() - distraction_start_;
+            auto elapsed = now() - distraction_start_;
             return std::chrono::duration<double>(elapsed).count() >= config.distraction_time_seconds;
         }
         else
@@ -2,48 +2,150 @@
 #include "../include/constants.h"
 #include "../include/cv_utils.h"
 #include "../include/logger.h"
+#include "../include/chunked_video_processor.h"
+#include "../include/multi_stream_server.h"
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <csignal>
 
 namespace DrowsinessDetector
 {
-    // DrowsinessDetectionSystem::DrowsinessDetectionSystem(const Config &config)
-    //     : config_(config),
-    //       detector_(std::make_unique<FacialLandmarkDetector>()),
-    //       state_tracker_(std::make_unique<StateTracker>()),
-    //       head_pose_detector_(std::make_unique<HeadPoseDetector>())
-    // {}
+    namespace
+    {
+        volatile std::sig_atomic_t stop_requested = 0;
+
+        extern "C" void handleStopSignal(int)
+        {
+            stop_requested = 1;
+        }
+    }
+
     DrowsinessDetectionSystem::DrowsinessDetectionSystem(const Config &config)
     {
         this->config_ = config;
-        this->detector_ = std::make_unique<FacialLandmarkDetector>();
-        this->state_tracker_ = std::make_unique<StateTracker>();
-        config.enable_head_pose_detection ? this->head_pose_detector_ = std::make_unique<HeadPoseDetector>() : this->head_pose_detector_ = nullptr;
+        this->analyzer_ = std::make_unique<FrameAnalyzer>(config);
     }
 
     bool DrowsinessDetectionSystem::initialize()
     {
-        bool detector_ok = detector_->initialize(config_.model_path);
-        if (!config_.enable_head_pose_detection)
-            return detector_ok;
-
-        bool head_pose_ok = head_pose_detector_->initialize(640, 480);
-
-        head_pose_detector_->setThresholds(
-            config_.head_pose_yaw_left_threshold,
-            config_.head_pose_yaw_right_threshold,
-            config_.head_pose_pitch_up_threshold,
-            config_.head_pose_pitch_down_threshold);
-
-        return detector_ok && head_pose_ok;
+        auto load_start = std::chrono::steady_clock::now();
+        landmark_predictor_ = LandmarkPredictor::load(config_);
+        auto load_end = std::chrono::steady_clock::now();
+        if (landmark_predictor_)
+        {
+            std::cout << "Landmark model ready in "
+                      << std::chrono::duration<double, std::milli>(load_end - load_start).count() << " ms ("
+                      << landmark_predictor_->getName() << " engine)" << std::endl;
+        }
+        return analyzer_->initialize(landmark_predictor_);
     }
 
     int DrowsinessDetectionSystem::run()
     {
+        std::signal(SIGINT, handleStopSignal);
+        std::signal(SIGTERM, handleStopSignal);
+
+        if (!config_.stream_sources.empty())
+        {
+            MultiStreamServer server(config_, landmark_predictor_);
+            int result = -1;
+            if (server.initialize())
+            {
+                result = server.run([]()
+                                    { return stop_requested != 0; });
+            }
+            cleanup();
+            return result;
+        }
+
+        if (config_.offline_workers > 1 && std::filesystem::exists(config_.video_path))
+        {
+            ChunkedVideoProcessor processor(config_, landmark_predictor_);
+            int result = processor.run();
+            cleanup();
+            return result;
+        }
+
         cv::VideoCapture cap;
+        if (!openVideoSource(cap))
+        {
+            std::cerr << "Failed to open video source" << std::endl;
+            return -1;
+        }
 
+        std::cout << "Drowsiness Detection System Started" << std::endl;
+        std::cout << (config_.headless ? "Send SIGINT/SIGTERM to exit" : "Press ESC to exit") << std::endl;
+
+        analyzer_->setUseEventTime(config_.use_video_timestamps && is_file_source_);
+
+        if (config_.enable_adaptive_frame_rate)
+        {
+            rate_controller_ = std::make_unique<AdaptiveRateController>(config_);
+            rate_controller_->setSourceFps(cap.get(cv::CAP_PROP_FPS));
+        }
+
+        if (config_.latest_frame_capture)
+        {
+            frame_grabber_ = std::make_unique<LatestFrameGrabber>(cap);
+            frame_grabber_->start(is_file_source_ ? cap.get(cv::CAP_PROP_FPS) : 0.0);
+        }
+
+        int result = config_.enable_pipeline ? runPipelined(cap) : runSequential(cap);
+
+        if (frame_grabber_)
+        {
+            frame_grabber_->stop();
+            size_t grabbed = 0, dropped = 0, delivered = 0;
+            frame_grabber_->getStats(grabbed, dropped, delivered);
+            std::cout << "Frames Grabbed: " << grabbed << " | Delivered: " << delivered
+                      << " | Dropped (stale): " << dropped << std::endl;
+            frame_grabber_.reset();
+        }
+        if (config_.enable_face_tracking)
+        {
+            size_t tracked = 0, detected = 0;
+            analyzer_->getLandmarkDetector().getTrackingStats(tracked, detected);
+            std::cout << "Face Boxes Tracked: " << tracked << " | Detected: " << detected << std::endl;
+        }
+        if (config_.enable_warm_start)
+        {
+            const LandmarkCostStats &cost = analyzer_->getLandmarkDetector().getLandmarkCostStats();
+            if (cost.predictions > 0 && cost.levels_full > 0)
+            {
+                const double levels_per_frame = static_cast<double>(cost.levels_run) / cost.predictions;
+                const double full_per_frame = static_cast<double>(cost.levels_full) / cost.predictions;
+                std::cout << "Landmark Warm Starts: " << cost.warm_starts << "/" << cost.predictions
+                          << " (" << cost.warm_start_fallbacks << " redone in full)"
+                          << " | Cascade levels per prediction: " << levels_per_frame << " of " << full_per_frame
+                          << " (" << 100.0 * (1.0 - levels_per_frame / full_per_frame) << "% saved)" << std::endl;
+            }
+        }
+        if (const PresenceGateStats *gate = analyzer_->getLandmarkDetector().getPresenceGateStats())
+        {
+            std::cout << "Presence Gate: " << gate->rejected << "/" << gate->checks << " frames skipped"
+                      << " | Passed: " << gate->passed << " (hits " << gate->hits
+                      << ", false alarms " << gate->false_alarms << ")"
+                      << " | Audit misses: " << gate->audit_misses << "/" << gate->audits << std::endl;
+        }
+        if (config_.frame_budget_ms > 0.0)
+        {
+            std::cout << "Deadline Misses: " << deadline_stats_.deadline_misses << "/" << deadline_stats_.frames
+                      << " frames | Pose skipped: " << deadline_stats_.pose_skipped
+                      << " | Overlays skipped: " << deadline_stats_.overlays_skipped
+                      << " | Snapshots skipped: " << deadline_stats_.snapshots_skipped << std::endl;
+        }
+        cleanup();
+        return result;
+    }
+
+    bool DrowsinessDetectionSystem::openVideoSource(cv::VideoCapture &cap)
+    {
         // Try to open video file or camera
-        if (!config_.video_path.empty() && std::filesystem::exists(config_.video_path))
+        is_file_source_ = !config_.video_path.empty() && std::filesystem::exists(config_.video_path);
+        if (is_file_source_)
         {
             cap.open(config_.video_path);
         }
@@ -51,96 +153,212 @@ namespace DrowsinessDetector
         {
             cap.open(0); // Default camera
         }
+        return cap.isOpened();
+    }
 
-        if (!cap.isOpened())
+    bool DrowsinessDetectionSystem::readFrame(cv::VideoCapture &cap, cv::Mat &frame, double &timestamp_ms, long long &frame_count)
+    {
+        // The grabber already drops stale frames, so frame_skip does not apply to it
+        if (frame_grabber_)
         {
-            std::cerr << "Failed to open video source" << std::endl;
-            return -1;
+            if (!frame_grabber_->takeLatest(frame, timestamp_ms))
+                return false;
+            ++frame_count;
+            return true;
         }
 
-        std::cout << "Drowsiness Detection System Started" << std::endl;
-        std::cout << "Press ESC to exit" << std::endl;
+        int frame_skip = rate_controller_ ? rate_controller_->getStride() : config_.frame_skip;
+        if (!CVUtils::readNextProcessedFrame(cap, frame, frame_count, frame_skip,
+                                             is_file_source_ && config_.seek_on_frame_skip))
+            return false;
+        timestamp_ms = cap.get(cv::CAP_PROP_POS_MSEC);
+        return true;
+    }
+
+    bool DrowsinessDetectionSystem::shouldStop()
+    {
+        if (stop_requested)
+            return true;
 
+        // Headless units have no window to pump, so waitKey's minimum delay is skipped entirely
+        if (config_.headless)
+            return false;
+        return cv::waitKey(Constants::WAIT_KEY_MS) == Constants::ESC_KEY;
+    }
+
+    int DrowsinessDetectionSystem::runSequential(cv::VideoCapture &cap)
+    {
         cv::Mat frame;
+        double timestamp_ms = 0.0;
 
-        int frame_count = 0;
+        long long frame_count = 0;
         int processed_frames = 0;
-        while (cap.read(frame))
+        while (readFrame(cap, frame, timestamp_ms, frame_count))
         {
-            if (frame.empty())
+            processFrame(frame, timestamp_ms);
+            processed_frames++;
+            if (shouldStop())
+            {
                 break;
+            }
+        }
+        std::cout << "Total Processed Frames: " << processed_frames << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int DrowsinessDetectionSystem::runPipelined(cv::VideoCapture &cap)
+    {
+        // Packets circulate free -> capture -> inference -> render -> free, so every
+        // frame buffer is allocated once and reused by cap.read for the whole run.
+        const size_t capacity = static_cast<size_t>(std::max(2, config_.pipeline_queue_capacity));
+        std::vector<FramePacket> packets(capacity);
+        BoundedQueue<FramePacket *> free_queue(capacity);
+        BoundedQueue<FramePacket *> inference_queue(capacity);
+        BoundedQueue<FramePacket *> render_queue(capacity);
+        for (auto &packet : packets)
+            free_queue.push(&packet);
+
+        std::thread capture_thread([&]()
+                                   {
+            long long frame_count = 0;
+            FramePacket *packet = nullptr;
+            while (free_queue.pop(packet))
+            {
+                if (!readFrame(cap, packet->frame, packet->timestamp_ms, frame_count))
+                    break;
+
+                packet->index = frame_count;
+                if (!inference_queue.push(packet))
+                    break;
+            }
+            inference_queue.close(); });
 
-            // Skip frames for performance if configured
-            if (++frame_count % config_.frame_skip != 0)
+        std::thread inference_thread([&]()
+                                     {
+            FramePacket *packet = nullptr;
+            while (inference_queue.pop(packet))
             {
-                std::cout << "Skipping frame " << frame_count << std::endl;
-                continue;
+                packet->result = analyzeFrame(packet->frame, packet->timestamp_ms);
+                if (!render_queue.push(packet))
+                    break;
             }
+            render_queue.close(); });
 
-            processFrame(frame);
+        // Render/log stage stays on the calling thread: HighGUI windows must be driven from it
+        int processed_frames = 0;
+        FramePacket *packet = nullptr;
+        while (render_queue.pop(packet))
+        {
+            renderFrame(packet->frame, packet->result);
             processed_frames++;
-            if (cv::waitKey(Constants::WAIT_KEY_MS) == Constants::ESC_KEY)
+            free_queue.push(packet);
+            if (shouldStop())
             {
                 break;
             }
         }
+
+        // Unblock whichever stage is still waiting, then drain
+        free_queue.close();
+        inference_queue.close();
+        render_queue.close();
+        capture_thread.join();
+        inference_thread.join();
+
         std::cout << "Total Processed Frames: " << processed_frames << std::endl;
-        cleanup();
         return EXIT_SUCCESS;
     }
 
-    void DrowsinessDetectionSystem::processFrame(cv::Mat &frame)
+    void DrowsinessDetectionSystem::processFrame(cv::Mat &frame, double timestamp_ms)
     {
-        cv::Rect face_rect;
-        std::vector<cv::Point2f> left_eye, right_eye, mouth;
-        dlib::full_object_detection all_landmarks;
+        FrameResult result = analyzeFrame(frame, timestamp_ms);
+        renderFrame(frame, result);
+    }
 
-        // Detect face and landmarks (including full landmarks for head pose)
-        bool face_detected = detector_->detectFaceAndAllLandmarks(frame, face_rect,
-                                                                  left_eye, right_eye, mouth,
-                                                                  all_landmarks);
+    FrameResult DrowsinessDetectionSystem::analyzeFrame(const cv::Mat &frame, double timestamp_ms)
+    {
+        FrameDeadline deadline(config_.frame_budget_ms);
+        FrameResult result = analyzer_->analyze(frame, timestamp_ms, &deadline);
+        if (result.pose_skipped)
+            deadline_stats_.pose_skipped++;
+
+        if (rate_controller_)
+            rate_controller_->update(result, deadline.elapsedMs());
+        return result;
+    }
+
+    void DrowsinessDetectionSystem::renderFrame(cv::Mat &frame, const FrameResult &result)
+    {
+        // The budget covers the whole frame, so it keeps counting from the start of inference
+        FrameDeadline deadline(config_.frame_budget_ms, result.processing_start);
 
-        if (!face_detected)
+        // Headless mode skips every overlay and window call; only logging remains
+        if (!config_.headless)
         {
-            drawNoFaceDetected(frame);
+            if (deadline.expired())
+            {
+                deadline_stats_.overlays_skipped++;
+            }
+            else if (!result.face_detected)
+            {
+                drawNoFaceDetected(frame);
+            }
+            else
+            {
+                if (analyzer_->isHeadPoseActive())
+                    drawVisualization(frame, result, result.head_pose);
+                else
+                    drawVisualization(frame, result);
+
+                // Draw head pose visualization
+                if (result.head_pose.is_valid && config_.show_head_direction_vector && analyzer_->isHeadPoseActive())
+                {
+                    drawHeadPoseVisualization(frame, result.head_pose, result.landmarks);
+                }
+            }
             cv::imshow("Drowsiness Detection System", frame);
-            config_.enable_head_pose_detection ? Logger::log(DriverState::NO_FACE_DETECTED, "No face detected", 0.0, 0.0, 0.0, frame) : Logger::log(DriverState::NO_FACE_DETECTED, "No face detected", 0.0, 0.0, frame);
-            return;
         }
 
-        // Calculate EAR and MAR
-        double left_ear = CVUtils::calculateEAR(left_eye);
-        double right_ear = CVUtils::calculateEAR(right_eye);
-        double avg_ear = (left_ear + right_ear) / 2.0;
-        double mar = CVUtils::calculateMAR(mouth);
+        logFrameResult(frame, result, deadline);
 
-        DriverState current_state;
-        HeadPose head_pose;
-        if (config_.enable_head_pose_detection && head_pose_detector_->isInitialized())
-        {
-            head_pose = head_pose_detector_->estimatePose(all_landmarks, frame.cols, frame.rows);
-            current_state = state_tracker_->updateState(avg_ear, mar, head_pose, config_);
-        }
-        current_state = state_tracker_->updateState(avg_ear, mar, config_);
+        deadline_stats_.frames++;
+        if (deadline.expired())
+            deadline_stats_.deadline_misses++;
+    }
 
-        if (config_.enable_head_pose_detection && head_pose_detector_->isInitialized())
-            drawVisualization(frame, face_rect, current_state, avg_ear, mar, head_pose);
-        else
-            drawVisualization(frame, face_rect, current_state, avg_ear, mar);
+    void DrowsinessDetectionSystem::logFrameResult(const cv::Mat &frame, const FrameResult &result,
+                                                   const FrameDeadline &deadline)
+    {
+        if (!FrameAnalyzer::shouldLog(result))
+            return;
 
-        // Draw head pose visualization
-        if (head_pose.is_valid && config_.show_head_direction_vector && head_pose_detector_->isInitialized() && config_.enable_head_pose_detection)
+        LogMetadata metadata;
+        if (is_file_source_)
+            metadata.media_time_ms = result.timestamp_ms;
+        metadata.perclos = result.perclos;
+        metadata.has_blink_stats = config_.enable_blink_detection;
+        metadata.blink_stats = result.blink_stats;
+        if (result.blink_ended)
+            metadata.blink_duration = result.blink_duration;
+
+        // The event itself is always logged; only the snapshot is shed over budget
+        static const cv::Mat no_snapshot;
+        const cv::Mat *snapshot = &frame;
+        if (config_.save_snapshots && deadline.expired())
         {
-            drawHeadPoseVisualization(frame, head_pose, all_landmarks);
+            snapshot = &no_snapshot;
+            deadline_stats_.snapshots_skipped++;
         }
-        cv::imshow("Drowsiness Detection System", frame);
 
-        // Log with head pose data
-        if (current_state != DriverState::ALERT)
+        if (!result.face_detected)
         {
-            std::string message = generateStateMessage(current_state);
-            config_.enable_head_pose_detection ? Logger::log(current_state, message, avg_ear, mar, head_pose.yaw, frame) : Logger::log(current_state, message, avg_ear, mar, frame);
+            config_.enable_head_pose_detection ? Logger::log(DriverState::NO_FACE_DETECTED, "No face detected", 0.0, 0.0, 0.0, *snapshot, metadata) : Logger::log(DriverState::NO_FACE_DETECTED, "No face detected", 0.0, 0.0, *snapshot, metadata);
+            return;
         }
+
+        // Log with head pose data; an ALERT frame here carries a blink event
+        std::string message = FrameAnalyzer::generateLogMessage(result);
+        config_.enable_head_pose_detection ? Logger::log(result.state, message, result.ear, result.mar, result.head_pose.yaw, *snapshot, metadata) : Logger::log(result.state, message, result.ear, result.mar, *snapshot, metadata);
     }
 
     void DrowsinessDetectionSystem::drawNoFaceDetected(cv::Mat &frame)
@@ -149,9 +367,13 @@ namespace DrowsinessDetector
                     cv::FONT_HERSHEY_SIMPLEX, 1.2, cv::Scalar(0, 0, 255), 2);
     }
 
-    void DrowsinessDetectionSystem::drawVisualization(cv::Mat &frame, const cv::Rect &face_rect, DriverState state,
-                                                      double ear, double mar, const HeadPose &head_pose)
+    void DrowsinessDetectionSystem::drawVisualization(cv::Mat &frame, const FrameResult &result, const HeadPose &head_pose)
     {
+        const cv::Rect &face_rect = result.face_rect;
+        DriverState state = result.state;
+        double ear = result.ear;
+        double mar = result.mar;
+
         // Draw face rectangle
         cv::Scalar color = CVUtils::getStateColor(state, config_);
         cv::rectangle(frame, face_rect, color, 3);
@@ -170,15 +392,19 @@ namespace DrowsinessDetector
                         cv::Point(50, 120), cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(255, 255, 255), 2);
 
             // Eyes closed duration
-            double eyes_closed_time = state_tracker_->getEyesClosedDuration();
+            double eyes_closed_time = result.eyes_closed_duration;
             cv::putText(frame, "Eyes Closed: " + CVUtils::formatDouble(eyes_closed_time, 1) + "s",
                         cv::Point(50, 150), cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(255, 255, 0), 2);
+
+            if (result.perclos >= 0.0)
+                cv::putText(frame, "PERCLOS: " + CVUtils::formatDouble(result.perclos * 100.0, 1) + "%",
+                            cv::Point(50, 180), cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(255, 255, 0), 2);
         }
 
         // NEW: Head pose information
         if (config_.show_head_pose_info && head_pose.is_valid)
         {
-            int y_offset = config_.show_debug_info ? 180 : 90;
+            int y_offset = config_.show_debug_info ? (result.perclos >= 0.0 ? 210 : 180) : 90;
 
             // Head direction
             std::string direction_text = "Head: " + HeadPoseDetector::headDirectionToString(head_pose.direction);
@@ -197,7 +423,7 @@ namespace DrowsinessDetector
                             cv::Point(50, y_offset + 70), cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(200, 200, 200), 1);
 
                 // Distraction duration
-                double distraction_time = state_tracker_->getDistractionDuration();
+                double distraction_time = result.distraction_duration;
                 if (distraction_time > 0.0)
                 {
                     cv::putText(frame, "Distracted: " + CVUtils::formatDouble(distraction_time, 1) + "s",
@@ -223,9 +449,13 @@ namespace DrowsinessDetector
     }
 
     //@ without head pose visualization
-    void DrowsinessDetectionSystem::drawVisualization(cv::Mat &frame, const cv::Rect &face_rect, DriverState state,
-                                                      double ear, double mar)
+    void DrowsinessDetectionSystem::drawVisualization(cv::Mat &frame, const FrameResult &result)
     {
+        const cv::Rect &face_rect = result.face_rect;
+        DriverState state = result.state;
+        double ear = result.ear;
+        double mar = result.mar;
+
         // Draw face rectangle
         cv::Scalar color = CVUtils::getStateColor(state, config_);
         cv::rectangle(frame, face_rect, color, 3);
@@ -244,10 +474,14 @@ namespace DrowsinessDetector
                         cv::Point(50, 120), cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(255, 255, 255), 2);
 
             // Eyes closed duration
-            double eyes_closed_time = state_tracker_->getEyesClosedDuration();
+            double eyes_closed_time = result.eyes_closed_duration;
             cv::putText(frame, "Eyes Closed: " + CVUtils::formatDouble(eyes_closed_time, 1) + "s",
                         cv::Point(50, 150), cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(255, 255, 0), 2);
 
+            if (result.perclos >= 0.0)
+                cv::putText(frame, "PERCLOS: " + CVUtils::formatDouble(result.perclos * 100.0, 1) + "%",
+                            cv::Point(50, 180), cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(255, 255, 0), 2);
+
             // Thresholds
             cv::putText(frame, "EAR Thresh: " + CVUtils::formatDouble(config_.ear_threshold),
                         cv::Point(50, frame.rows - 100), cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(200, 200, 200), 1);
@@ -257,13 +491,13 @@ namespace DrowsinessDetector
     }
 
     void DrowsinessDetectionSystem::drawHeadPoseVisualization(cv::Mat &frame, const HeadPose &head_pose,
-                                                              const dlib::full_object_detection &landmarks)
+                                                              const FaceLandmarks &landmarks)
     {
         if (!head_pose.is_valid)
             return;
 
-        // Get nose tip point (landmark 30)
-        cv::Point2f nose_tip(landmarks.part(30).x(), landmarks.part(30).y());
+        // Get nose tip point
+        cv::Point2f nose_tip = landmarks.point(LandmarkLayout::NOSE_TIP);
 
         // Calculate direction vector endpoint based on yaw and pitch
         float vector_length = 100.0f;
@@ -279,28 +513,10 @@ namespace DrowsinessDetector
         cv::circle(frame, nose_tip, 5, cv::Scalar(255, 0, 0), -1);
     }
 
-    std::string DrowsinessDetectionSystem::generateStateMessage(DriverState state)
-    {
-        switch (state)
-        {
-        case DriverState::DROWSY:
-            return "Driver showing signs of drowsiness";
-        case DriverState::YAWNING:
-            return "Driver is yawning";
-        case DriverState::DROWSY_YAWNING:
-            return "Driver is drowsy and yawning - HIGH RISK";
-        case DriverState::DISTRACTED:
-            return "Driver is looking away from the road";
-        case DriverState::DROWSY_DISTRACTED:
-            return "Driver is drowsy and distracted - CRITICAL RISK";
-        default:
-            return "State change detected";
-        }
-    }
-
     void DrowsinessDetectionSystem::cleanup()
     {
-        cv::destroyAllWindows();
+        if (!config_.headless)
+            cv::destroyAllWindows();
         Logger::shutdown();
         std::cout << "System shutdown complete" << std::endl;
     }
@@ -0,0 +1,64 @@
+#include "../include/face_detector.h"
+#include "../include/hog_face_detector.h"
+#include "../include/haar_face_detector.h"
+#include "../include/yunet_face_detector.h"
+#include <cmath>
+#include <iostream>
+
+namespace DrowsinessDetector
+{
+    dlib::rectangle FaceDetector::toHogGeometry(double x, double y, double width, double height,
+                                                const FaceBoxCalibration &calibration)
+    {
+        const double center_x = x + width / 2.0 + calibration.offset_x * width;
+        const double center_y = y + height / 2.0 + calibration.offset_y * height;
+        const double mapped_width = width * calibration.scale_x;
+        const double mapped_height = height * calibration.scale_y;
+        const long left = std::lround(center_x - mapped_width / 2.0);
+        const long top = std::lround(center_y - mapped_height / 2.0);
+        return dlib::rectangle(left, top, left + std::lround(mapped_width) - 1, top + std::lround(mapped_height) - 1);
+    }
+
+    std::unique_ptr<FaceDetector> FaceDetector::create(const Config &config)
+    {
+        return create(config.face_detector_backend, config);
+    }
+
+    std::unique_ptr<FaceDetector> FaceDetector::create(FaceDetectorBackend backend, const Config &config)
+    {
+        try
+        {
+            switch (backend)
+            {
+            case FaceDetectorBackend::HOG:
+                return std::make_unique<HogFaceDetector>(config);
+
+            case FaceDetectorBackend::HAAR:
+            {
+                auto detector = std::make_unique<HaarFaceDetector>(config);
+                if (!detector->initialize(config.haar_cascade_path))
+                    return nullptr;
+                return detector;
+            }
+
+            case FaceDetectorBackend::YUNET:
+            {
+#ifdef DROWSINESS_HAVE_YUNET
+                auto detector = std::make_unique<YuNetFaceDetector>(config);
+                if (!detector->initialize(config.yunet_model_path))
+                    return nullptr;
+                return detector;
+#else
+                std::cerr << "YuNet face detector requires OpenCV 4.5.4 or newer" << std::endl;
+                return nullptr;
+#endif
+            }
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to create face detector: " << e.what() << std::endl;
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,163 @@
+#include "../include/face_ratio_kernel.h"
+#include "../include/constants.h"
+#include <array>
+#include <cmath>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FACE_RATIO_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FACE_RATIO_NEON 1
+#endif
+
+namespace DrowsinessDetector
+{
+    namespace FaceRatioKernel
+    {
+        namespace
+        {
+            using Layout = LandmarkLayout;
+            constexpr size_t LEFT_VERTICALS = Layout::LEFT_EYE.verticals.size();
+            constexpr size_t RIGHT_VERTICALS = Layout::RIGHT_EYE.verticals.size();
+            constexpr size_t MOUTH_VERTICALS = Layout::MOUTH.verticals.size();
+
+            // Segments in the order combine() reads them: each table's verticals, then its horizontal
+            constexpr size_t LEFT_FIRST = 0;
+            constexpr size_t RIGHT_FIRST = LEFT_FIRST + LEFT_VERTICALS + 1;
+            constexpr size_t MOUTH_FIRST = RIGHT_FIRST + RIGHT_VERTICALS + 1;
+            constexpr size_t SEGMENTS = MOUTH_FIRST + MOUTH_VERTICALS + 1;
+
+            template <size_t V>
+            constexpr void appendTable(std::array<PointPair, SEGMENTS> &segments, size_t first, const AspectRatioTable<V> &table)
+            {
+                for (size_t i = 0; i < V; ++i)
+                    segments[first + i] = table.verticals[i];
+                segments[first + V] = table.horizontal;
+            }
+
+            constexpr std::array<PointPair, SEGMENTS> makeSegments()
+            {
+                std::array<PointPair, SEGMENTS> segments{};
+                appendTable(segments, LEFT_FIRST, Layout::LEFT_EYE);
+                appendTable(segments, RIGHT_FIRST, Layout::RIGHT_EYE);
+                appendTable(segments, MOUTH_FIRST, Layout::MOUTH);
+                return segments;
+            }
+
+            constexpr std::array<PointPair, SEGMENTS> SEGMENT_TABLE = makeSegments();
+
+            // Single frame: segments padded to whole 4-wide vectors
+            constexpr size_t PADDED_SEGMENTS = (SEGMENTS + 3) / 4 * 4;
+            constexpr int BATCH_LANES = 4;
+
+            // d[k * stride] is the length of segment k
+            template <size_t V>
+            double tableRatio(const float *d, int stride, size_t first)
+            {
+                double vertical = 0.0;
+                for (size_t i = 0; i < V; ++i)
+                    vertical += d[(first + i) * stride];
+                const double horizontal = d[(first + V) * stride];
+                return (horizontal < Constants::EPSILON) ? 0.0 : vertical / (2.0 * horizontal);
+            }
+
+            FaceRatios combine(const float *d, int stride)
+            {
+                FaceRatios ratios;
+                ratios.left_ear = tableRatio<LEFT_VERTICALS>(d, stride, LEFT_FIRST);
+                ratios.right_ear = tableRatio<RIGHT_VERTICALS>(d, stride, RIGHT_FIRST);
+                ratios.mar = tableRatio<MOUTH_VERTICALS>(d, stride, MOUTH_FIRST);
+                return ratios;
+            }
+
+            // Differences along segment k, fully unrolled over the constant table
+            template <size_t... K>
+            void gatherSegments(const FaceLandmarks &landmarks, float *dx, float *dy, int stride, std::index_sequence<K...>)
+            {
+                ((dx[K * stride] = landmarks.x[SEGMENT_TABLE[K].from] - landmarks.x[SEGMENT_TABLE[K].to]), ...);
+                ((dy[K * stride] = landmarks.y[SEGMENT_TABLE[K].from] - landmarks.y[SEGMENT_TABLE[K].to]), ...);
+            }
+
+            // length[i] = sqrt(dx[i]^2 + dy[i]^2); n is a multiple of 4, arrays 16-byte aligned
+            void segmentLengths(const float *dx, const float *dy, float *length, int n)
+            {
+#if defined(FACE_RATIO_SSE2)
+                for (int i = 0; i < n; i += 4)
+                {
+                    const __m128 x = _mm_load_ps(dx + i);
+                    const __m128 y = _mm_load_ps(dy + i);
+                    _mm_store_ps(length + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))));
+                }
+#elif defined(FACE_RATIO_NEON)
+                for (int i = 0; i < n; i += 4)
+                {
+                    const float32x4_t x = vld1q_f32(dx + i);
+                    const float32x4_t y = vld1q_f32(dy + i);
+                    vst1q_f32(length + i, vsqrtq_f32(vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y))));
+                }
+#else
+                for (int i = 0; i < n; ++i)
+                    length[i] = std::sqrt(dx[i] * dx[i] + dy[i] * dy[i]);
+#endif
+            }
+        }
+
+        FaceRatios compute(const FaceLandmarks &landmarks)
+        {
+            if (!landmarks.isComplete())
+                return FaceRatios();
+
+            alignas(16) float dx[PADDED_SEGMENTS] = {};
+            alignas(16) float dy[PADDED_SEGMENTS] = {};
+            alignas(16) float length[PADDED_SEGMENTS];
+            gatherSegments(landmarks, dx, dy, 1, std::make_index_sequence<SEGMENTS>());
+            segmentLengths(dx, dy, length, static_cast<int>(PADDED_SEGMENTS));
+            return combine(length, 1);
+        }
+
+        void computeBatch(const FaceLandmarks *landmarks, size_t count, FaceRatios *ratios)
+        {
+            // Segment-major, frame-minor: every vector holds one segment of four frames
+            alignas(16) float dx[SEGMENTS * BATCH_LANES];
+            alignas(16) float dy[SEGMENTS * BATCH_LANES];
+            alignas(16) float length[SEGMENTS * BATCH_LANES];
+
+            size_t frame = 0;
+            for (; frame + BATCH_LANES <= count; frame += BATCH_LANES)
+            {
+                const FaceLandmarks *group = landmarks + frame;
+                bool complete = true;
+                for (int lane = 0; lane < BATCH_LANES; ++lane)
+                    complete = complete && group[lane].isComplete();
+                if (!complete)
+                {
+                    for (int lane = 0; lane < BATCH_LANES; ++lane)
+                        ratios[frame + lane] = compute(group[lane]);
+                    continue;
+                }
+
+                for (int lane = 0; lane < BATCH_LANES; ++lane)
+                    gatherSegments(group[lane], dx + lane, dy + lane, BATCH_LANES, std::make_index_sequence<SEGMENTS>());
+                segmentLengths(dx, dy, length, static_cast<int>(SEGMENTS * BATCH_LANES));
+                for (int lane = 0; lane < BATCH_LANES; ++lane)
+                    ratios[frame + lane] = combine(length + lane, BATCH_LANES);
+            }
+
+            for (; frame < count; ++frame)
+                ratios[frame] = compute(landmarks[frame]);
+        }
+
+        const char *getInstructionSet()
+        {
+#if defined(FACE_RATIO_SSE2)
+            return "SSE2";
+#elif defined(FACE_RATIO_NEON)
+            return "NEON";
+#else
+            return "scalar";
+#endif
+        }
+    }
+}
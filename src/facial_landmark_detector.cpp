@@ -2,15 +2,40 @@
 #include "../include/constants.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 
 namespace DrowsinessDetector
 {
+    FacialLandmarkDetector::FacialLandmarkDetector(const Config &config)
+    {
+        this->config_ = config;
+    }
+
     bool FacialLandmarkDetector::initialize(const std::string &model_path)
     {
+        Config config = config_;
+        config.model_path = model_path;
+        return initialize(LandmarkPredictor::load(config));
+    }
+
+    bool FacialLandmarkDetector::initialize(std::shared_ptr<const LandmarkPredictor> landmark_predictor)
+    {
+        if (!landmark_predictor)
+            return false;
+
         try
         {
-            face_detector_ = dlib::get_frontal_face_detector();
-            dlib::deserialize(model_path) >> landmark_predictor_;
+            face_detector_ = FaceDetector::create(config_);
+            if (!face_detector_)
+                return false;
+
+            if (config_.presence_gate_mode != PresenceGateMode::OFF)
+            {
+                presence_gate_ = std::make_unique<PresenceGate>(config_);
+                if (!presence_gate_->initialize())
+                    return false;
+            }
+            landmark_predictor_ = std::move(landmark_predictor);
             is_initialized_ = true;
             return true;
         }
@@ -21,41 +46,80 @@ namespace DrowsinessDetector
         }
     }
 
-    bool FacialLandmarkDetector::detectFaceAndAllLandmarks(const cv::Mat &frame, cv::Rect &face_rect,
-                                                           std::vector<cv::Point2f> &left_eye,
-                                                           std::vector<cv::Point2f> &right_eye,
-                                                           std::vector<cv::Point2f> &mouth,
-                                                           dlib::full_object_detection &all_landmarks)
+    bool FacialLandmarkDetector::detectFaceAndLandmarks(const cv::Mat &frame, cv::Rect &face_rect, FaceLandmarks &landmarks)
     {
         if (!is_initialized_ || frame.empty())
             return false;
 
         try
         {
-            dlib::cv_image<dlib::bgr_pixel> dlib_img(frame);
-            std::vector<dlib::rectangle> faces = face_detector_(dlib_img);
+            dlib::rectangle face;
 
-            if (faces.empty())
-                return false;
+            // Between detections the face box comes from the previous frame's landmarks
+            bool tracked = config_.enable_face_tracking && have_tracked_face_ &&
+                           frames_since_detection_ < config_.tracking_redetect_interval;
+            if (tracked)
+            {
+                face = trackedFaceBox();
+                predictLandmarks(frame, face, landmarks);
+
+                // Landmarks jumped or collapsed, or the box no longer shows the detected face: re-detect now
+                if (!landmarks.isComplete() || !isTrackingConsistent(landmarks.bounds()) ||
+                    !matchesAppearance(frame, landmarks.bounds()))
+                    tracked = false;
+                else
+                {
+                    // Tracking must not follow a face out of the driver seat
+                    const dlib::point c = dlib::center(landmarks.bounds());
+                    tracked = driverRegion(frame).contains(cv::Point(c.x(), c.y()));
+                }
+            }
 
-            // Use the largest face (most confident detection)
-            dlib::rectangle face = *std::max_element(faces.begin(), faces.end(),
-                                                     [](const dlib::rectangle &a, const dlib::rectangle &b)
-                                                     {
-                                                         return a.area() < b.area();
-                                                     });
+            if (!tracked)
+            {
+                // Nobody there by the cheap check: skip the full detector
+                if (presence_gate_ &&
+                    !presence_gate_->check(frame(driverRegion(frame)), have_previous_face_location_))
+                {
+                    have_tracked_face_ = false;
+                    return false;
+                }
 
-            all_landmarks = landmark_predictor_(dlib_img, face);
-            if (all_landmarks.num_parts() != Constants::FACE_LANDMARK_COUNT)
+                const bool found = detectFace(frame, face);
+                if (presence_gate_)
+                    presence_gate_->report(found);
+                if (!found)
+                {
+                    have_tracked_face_ = false;
+                    have_previous_landmarks_ = false;
+                    return false;
+                }
+                predictLandmarks(frame, face, landmarks);
+            }
+
+            if (!landmarks.isComplete())
+            {
+                have_tracked_face_ = false;
+                have_previous_landmarks_ = false;
                 return false;
+            }
+            updateTracking(frame, face, landmarks, tracked);
+
+            previous_landmarks_ = landmarks;
+            previous_face_box_ = face;
+            have_previous_landmarks_ = true;
 
-            // Convert to OpenCV format and extract features
             face_rect = cv::Rect(face.left(), face.top(), face.width(), face.height()) &
                         cv::Rect(0, 0, frame.cols, frame.rows);
 
-            extractEyePoints(all_landmarks, LandmarkIndices::LEFT_EYE_START, LandmarkIndices::LEFT_EYE_END, left_eye);
-            extractEyePoints(all_landmarks, LandmarkIndices::RIGHT_EYE_START, LandmarkIndices::RIGHT_EYE_END, right_eye);
-            extractMouthPoints(all_landmarks, mouth);
+            // Keep the ROI window following a tracked face so the next re-detection stays cheap
+            if (tracked)
+            {
+                if (presence_gate_)
+                    presence_gate_->invalidate();
+                last_face_rect_ = face_rect;
+                have_previous_face_location_ = !face_rect.empty();
+            }
             return true;
         }
         catch (const std::exception &e)
@@ -65,23 +129,299 @@ namespace DrowsinessDetector
         }
     }
 
-    void FacialLandmarkDetector::extractEyePoints(const dlib::full_object_detection &landmarks, int start, int end,
-                                                  std::vector<cv::Point2f> &eye_points)
+    bool FacialLandmarkDetector::detectFace(const cv::Mat &frame, dlib::rectangle &face)
+    {
+        // Everything outside the driver-seat region (passengers, rear seats) is never scanned
+        const cv::Rect scan_region = driverRegion(frame);
+
+        // Search an expanded window around the previous face unless a periodic full scan is due
+        bool use_roi = config_.enable_roi_redetection && have_previous_face_location_ &&
+                       frames_since_full_scan_ < config_.roi_full_scan_interval;
+
+        std::vector<dlib::rectangle> faces;
+        if (use_roi)
+        {
+            const double scale = std::max(1.0, config_.roi_expansion);
+            const int width = static_cast<int>(last_face_rect_.width * scale);
+            const int height = static_cast<int>(last_face_rect_.height * scale);
+            const cv::Point center(last_face_rect_.x + last_face_rect_.width / 2,
+                                   last_face_rect_.y + last_face_rect_.height / 2);
+            cv::Rect search_area = cv::Rect(center.x - width / 2, center.y - height / 2, width, height) & scan_region;
+
+            faces = scanForFaces(frame, search_area);
+
+            // Missed inside the window: fall back to a full-frame scan on the same frame
+            if (faces.empty())
+                use_roi = false;
+        }
+        if (!use_roi)
+            faces = scanForFaces(frame, scan_region);
+
+        frames_since_full_scan_ = use_roi ? frames_since_full_scan_ + 1 : 0;
+
+        // Boxes can spill past the scanned area; only faces centred in the driver region count
+        faces.erase(std::remove_if(faces.begin(), faces.end(),
+                                   [&scan_region](const dlib::rectangle &candidate)
+                                   {
+                                       const dlib::point c = dlib::center(candidate);
+                                       return !scan_region.contains(cv::Point(c.x(), c.y()));
+                                   }),
+                    faces.end());
+
+        if (faces.empty())
+        {
+            have_previous_face_location_ = false;
+            return false;
+        }
+
+        // Use the largest face (most confident detection)
+        face = *std::max_element(faces.begin(), faces.end(),
+                                 [](const dlib::rectangle &a, const dlib::rectangle &b)
+                                 {
+                                     return a.area() < b.area();
+                                 });
+
+        last_face_rect_ = cv::Rect(face.left(), face.top(), face.width(), face.height()) &
+                          cv::Rect(0, 0, frame.cols, frame.rows);
+        have_previous_face_location_ = !last_face_rect_.empty();
+        return true;
+    }
+
+    void FacialLandmarkDetector::predictLandmarks(const cv::Mat &frame, const dlib::rectangle &face, FaceLandmarks &landmarks)
+    {
+        const size_t levels = landmark_predictor_->getCascadeLevels();
+        const bool warm_start = config_.enable_warm_start && landmark_predictor_->supportsWarmStart() &&
+                                have_previous_landmarks_ &&
+                                frames_since_full_cascade_ < config_.warm_start_refresh_interval &&
+                                isSmallMotion(previous_face_box_, face);
+
+        landmark_cost_.predictions++;
+        landmark_cost_.levels_full += levels;
+        if (warm_start)
+        {
+            const size_t warm_levels = std::min(levels, static_cast<size_t>(std::max(1, config_.warm_start_levels)));
+            landmark_cost_.warm_starts++;
+            landmark_cost_.levels_run += warm_levels;
+            landmark_predictor_->predictFrom(frame, face, previous_landmarks_, warm_levels, landmarks);
+
+            // On tracked frames the face box comes from the previous landmarks, so the box test
+            // above cannot see motion; check how far the warm-started shape itself moved
+            if (isSmallMotion(previous_landmarks_.bounds(), landmarks.bounds()))
+            {
+                frames_since_full_cascade_++;
+                return;
+            }
+            landmark_cost_.warm_start_fallbacks++;
+        }
+
+        frames_since_full_cascade_ = 0;
+        landmark_cost_.levels_run += levels;
+        landmark_predictor_->predict(frame, face, landmarks);
+    }
+
+    bool FacialLandmarkDetector::isSmallMotion(const dlib::rectangle &previous, const dlib::rectangle &current) const
+    {
+        // The previous shape is only a good start if the box barely moved
+        if (current.is_empty() || previous.is_empty())
+            return false;
+
+        const double width = static_cast<double>(previous.width());
+        const double shift = std::max(std::abs(dlib::center(current).x() - dlib::center(previous).x()),
+                                      std::abs(dlib::center(current).y() - dlib::center(previous).y())) / width;
+        const double size_change = std::abs(static_cast<double>(current.width()) - width) / width;
+        return shift <= config_.warm_start_max_motion && size_change <= config_.warm_start_max_motion;
+    }
+
+    cv::Rect FacialLandmarkDetector::driverRegion(const cv::Mat &frame) const
+    {
+        const cv::Rect frame_rect(0, 0, frame.cols, frame.rows);
+        if (!config_.enable_driver_region)
+            return frame_rect;
+
+        const cv::Rect2d &region = config_.driver_region;
+        const cv::Rect pixels(static_cast<int>(region.x * frame.cols), static_cast<int>(region.y * frame.rows),
+                              static_cast<int>(region.width * frame.cols), static_cast<int>(region.height * frame.rows));
+        return pixels & frame_rect;
+    }
+
+    dlib::rectangle FacialLandmarkDetector::trackedFaceBox() const
+    {
+        // Re-apply the detector-box/landmark-box relation measured at the last detection
+        const dlib::rectangle &box = previous_landmark_box_;
+        const double center_x = dlib::center(box).x() + box_offset_x_ * box.width();
+        const double center_y = dlib::center(box).y() + box_offset_y_ * box.height();
+        const double width = box_scale_x_ * box.width();
+        const double height = box_scale_y_ * box.height();
+        return dlib::centered_rect(dlib::point(static_cast<long>(center_x), static_cast<long>(center_y)),
+                                   static_cast<unsigned long>(width), static_cast<unsigned long>(height));
+    }
+
+    bool FacialLandmarkDetector::isTrackingConsistent(const dlib::rectangle &landmark_box) const
+    {
+        const dlib::rectangle &previous = previous_landmark_box_;
+        if (landmark_box.is_empty() || previous.is_empty())
+            return false;
+
+        const double shift_x = std::abs(dlib::center(landmark_box).x() - dlib::center(previous).x()) / static_cast<double>(previous.width());
+        const double shift_y = std::abs(dlib::center(landmark_box).y() - dlib::center(previous).y()) / static_cast<double>(previous.height());
+        const double scale_change = std::abs(static_cast<double>(landmark_box.width()) / previous.width() - 1.0);
+
+        return shift_x <= config_.tracking_max_shift && shift_y <= config_.tracking_max_shift &&
+               scale_change <= config_.tracking_max_scale_change;
+    }
+
+    bool FacialLandmarkDetector::matchesAppearance(const cv::Mat &frame, const dlib::rectangle &landmark_box) const
+    {
+        if (config_.tracking_min_appearance <= 0.0)
+            return true;
+        if (!have_face_template_)
+            return false;
+
+        AppearancePatch patch;
+        if (!sampleAppearance(frame, landmark_box, patch))
+            return false;
+
+        // Both patches are zero-mean and unit-norm, so the dot product is their normalized correlation
+        double correlation = 0.0;
+        for (size_t i = 0; i < patch.size(); ++i)
+            correlation += static_cast<double>(patch[i]) * face_template_[i];
+        return correlation >= config_.tracking_min_appearance;
+    }
+
+    bool FacialLandmarkDetector::sampleAppearance(const cv::Mat &frame, const dlib::rectangle &box, AppearancePatch &patch)
+    {
+        const cv::Rect area = cv::Rect(box.left(), box.top(), box.width(), box.height()) &
+                              cv::Rect(0, 0, frame.cols, frame.rows);
+        if (area.width < APPEARANCE_SIZE || area.height < APPEARANCE_SIZE || frame.depth() != CV_8U)
+            return false;
+
+        // Each cell averages a 2x2 grid of pixels in luma; no buffers, so tracked frames stay allocation-free
+        const int channels = frame.channels();
+        double sum = 0.0;
+        for (int gy = 0; gy < APPEARANCE_SIZE; ++gy)
+        {
+            for (int gx = 0; gx < APPEARANCE_SIZE; ++gx)
+            {
+                float value = 0.0f;
+                for (int sy = 0; sy < 2; ++sy)
+                {
+                    const int py = area.y + (4 * gy + 2 * sy + 1) * area.height / (4 * APPEARANCE_SIZE);
+                    const uchar *row = frame.ptr<uchar>(py);
+                    for (int sx = 0; sx < 2; ++sx)
+                    {
+                        const uchar *pixel = row + ((area.x + (4 * gx + 2 * sx + 1) * area.width / (4 * APPEARANCE_SIZE)) * channels);
+                        value += channels >= 3 ? 0.114f * pixel[0] + 0.587f * pixel[1] + 0.299f * pixel[2] : pixel[0];
+                    }
+                }
+                patch[gy * APPEARANCE_SIZE + gx] = value;
+                sum += value;
+            }
+        }
+
+        const float mean = static_cast<float>(sum / patch.size());
+        double norm = 0.0;
+        for (float &value : patch)
+        {
+            value -= mean;
+            norm += static_cast<double>(value) * value;
+        }
+        if (norm < 1e-6)
+            return false; // Flat patch (covered lens, black frame): nothing to compare
+
+        const float scale = static_cast<float>(1.0 / std::sqrt(norm));
+        for (float &value : patch)
+            value *= scale;
+        return true;
+    }
+
+    void FacialLandmarkDetector::updateTracking(const cv::Mat &frame, const dlib::rectangle &face, const FaceLandmarks &landmarks, bool tracked)
     {
-        eye_points.clear();
-        for (int i = start; i < (end + 1); ++i)
+        const dlib::rectangle landmark_box = landmarks.bounds();
+        if (landmark_box.is_empty())
+        {
+            have_tracked_face_ = false;
+            return;
+        }
+
+        if (tracked)
         {
-            eye_points.emplace_back(landmarks.part(i).x(), landmarks.part(i).y());
+            frames_since_detection_++;
+            frames_tracked_++;
+        }
+        else
+        {
+            frames_since_detection_ = 0;
+            frames_detected_++;
+            box_offset_x_ = (dlib::center(face).x() - dlib::center(landmark_box).x()) / static_cast<double>(landmark_box.width());
+            box_offset_y_ = (dlib::center(face).y() - dlib::center(landmark_box).y()) / static_cast<double>(landmark_box.height());
+            box_scale_x_ = static_cast<double>(face.width()) / landmark_box.width();
+            box_scale_y_ = static_cast<double>(face.height()) / landmark_box.height();
+
+            // Reference appearance for the tracked frames until the next detection
+            have_face_template_ = config_.tracking_min_appearance > 0.0 &&
+                                  sampleAppearance(frame, landmark_box, face_template_);
         }
+
+        previous_landmark_box_ = landmark_box;
+        have_tracked_face_ = config_.enable_face_tracking;
+    }
+
+    const PresenceGateStats *FacialLandmarkDetector::getPresenceGateStats() const
+    {
+        return presence_gate_ ? &presence_gate_->getStats() : nullptr;
     }
 
-    void FacialLandmarkDetector::extractMouthPoints(const dlib::full_object_detection &landmarks,
-                                                    std::vector<cv::Point2f> &mouth_points)
+    void FacialLandmarkDetector::getTrackingStats(size_t &tracked, size_t &detected) const
     {
-        mouth_points.clear();
-        for (int i = LandmarkIndices::MOUTH_START; i < (LandmarkIndices::MOUTH_END + 1); ++i)
+        tracked = frames_tracked_;
+        detected = frames_detected_;
+    }
+
+    std::vector<dlib::rectangle> FacialLandmarkDetector::scanForFaces(const cv::Mat &frame, const cv::Rect &search_area)
+    {
+        if (search_area.empty())
+            return {};
+
+        // cv_image wraps the ROI in place (it honours the parent's row stride), no copy
+        cv::Mat region = frame(search_area);
+        const dlib::point offset(search_area.x, search_area.y);
+
+        // A minimum face size above the HOG window lowers the scale further, dropping the finest levels
+        double scale = (config_.detection_scale > 0.0 && config_.detection_scale < 1.0) ? config_.detection_scale : 1.0;
+        scale = std::min(scale, face_detector_->getMinFaceScale());
+        if (scale >= 1.0)
+        {
+            std::vector<dlib::rectangle> faces = face_detector_->detect(region);
+            for (auto &detected : faces)
+                detected = dlib::translate_rect(detected, offset);
+            return faces;
+        }
+
+        // HOG runs on a downsampled grayscale copy; landmarks still use the full-resolution frame
+        if (region.channels() == 3)
+            cv::cvtColor(region, gray_buffer_, cv::COLOR_BGR2GRAY);
+        else
+            gray_buffer_ = region;
+        cv::resize(gray_buffer_, scaled_buffer_, cv::Size(), scale, scale, cv::INTER_AREA);
+
+        std::vector<dlib::rectangle> faces = face_detector_->detect(scaled_buffer_);
+
+        // Map boxes back to frame coordinates
+        for (auto &detected : faces)
         {
-            mouth_points.emplace_back(landmarks.part(i).x(), landmarks.part(i).y());
+            dlib::rectangle mapped(static_cast<long>(detected.left() / scale),
+                                   static_cast<long>(detected.top() / scale),
+                                   static_cast<long>((detected.right() + 1) / scale) - 1,
+                                   static_cast<long>((detected.bottom() + 1) / scale) - 1);
+            detected = dlib::translate_rect(mapped, offset);
         }
+        return faces;
+    }
+
+    std::vector<dlib::rectangle> FacialLandmarkDetector::detectFaces(const cv::Mat &frame)
+    {
+        if (!is_initialized_ || frame.empty())
+            return {};
+        return scanForFaces(frame, cv::Rect(0, 0, frame.cols, frame.rows));
     }
 }
\ No newline at end of file
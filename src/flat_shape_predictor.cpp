@@ -0,0 +1,628 @@
+#include "../include/flat_shape_predictor.h"
+#include <dlib/image_processing/shape_predictor.h>
+#include <dlib/geometry.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DrowsinessDetector
+{
+    namespace
+    {
+        /**
+         * Reader for dlib's serialization format: integers are a control byte
+         * (0x80 = negative, low nibble = byte count) followed by little-endian
+         * bytes; floats are a packed int64 mantissa and int16 exponent, or ASCII
+         * text in files written before dlib switched formats.
+         */
+        class DatReader
+        {
+        private:
+            const unsigned char *pos_;
+            const unsigned char *end_;
+
+            unsigned char next()
+            {
+                if (pos_ == end_)
+                    throw std::runtime_error("unexpected end of model file");
+                return *pos_++;
+            }
+
+            uint64_t readMagnitude(unsigned char control)
+            {
+                const unsigned size = control & 0x0F;
+                if (size > 8)
+                    throw std::runtime_error("corrupt integer in model file");
+                uint64_t value = 0;
+                for (unsigned i = 0; i < size; ++i)
+                    value |= static_cast<uint64_t>(next()) << (8 * i);
+                return value;
+            }
+
+            float readAsciiFloat()
+            {
+                std::string text;
+                for (unsigned char c = next(); c != ' '; c = next())
+                    text.push_back(static_cast<char>(c));
+                if (text == "inf")
+                    return std::numeric_limits<float>::infinity();
+                if (text == "ninf")
+                    return -std::numeric_limits<float>::infinity();
+                if (text == "nan")
+                    return std::numeric_limits<float>::quiet_NaN();
+                return std::stof(text);
+            }
+
+        public:
+            DatReader(const unsigned char *data, size_t size) : pos_(data), end_(data + size) {}
+
+            uint64_t readUnsigned()
+            {
+                const unsigned char control = next();
+                if (control & 0x80)
+                    throw std::runtime_error("negative value where an unsigned one was expected");
+                return readMagnitude(control);
+            }
+
+            int64_t readSigned()
+            {
+                const unsigned char control = next();
+                const int64_t value = static_cast<int64_t>(readMagnitude(control));
+                return (control & 0x80) ? -value : value;
+            }
+
+            float readFloat()
+            {
+                if (pos_ == end_)
+                    throw std::runtime_error("unexpected end of model file");
+                if ((*pos_ & 0x70) != 0)
+                    return readAsciiFloat();
+
+                const int64_t mantissa = readSigned();
+                const int64_t exponent = readSigned();
+                // dlib's float_details reserves exponents 32000+ for inf, -inf and nan
+                if (exponent >= 32000)
+                {
+                    if (exponent == 32000)
+                        return std::numeric_limits<float>::infinity();
+                    if (exponent == 32001)
+                        return -std::numeric_limits<float>::infinity();
+                    return std::numeric_limits<float>::quiet_NaN();
+                }
+                return std::ldexp(static_cast<float>(mantissa), static_cast<int>(exponent));
+            }
+
+            void readColumnVector(std::vector<float> &values)
+            {
+                // Newer dlib writes negated dimensions to mark the current format
+                const int64_t rows = std::llabs(readSigned());
+                const int64_t cols = std::llabs(readSigned());
+                values.resize(static_cast<size_t>(rows * cols));
+                for (auto &value : values)
+                    value = readFloat();
+            }
+        };
+
+        // dlib::shape_predictor members as read from the file, already flattened per level
+        struct ParsedModel
+        {
+            std::vector<float> initial_shape;
+            uint32_t num_levels = 0;
+            uint32_t trees_per_level = 0;
+            uint32_t num_splits = 0;
+            uint32_t num_leaves = 0;
+            uint32_t features_per_level = 0;
+            std::vector<FlatSplit> splits;
+            std::vector<float> leaves;
+            std::vector<uint32_t> anchors;
+            std::vector<float> deltas; // Per level: x block, then y block
+        };
+
+        void parseForests(DatReader &reader, ParsedModel &model)
+        {
+            const size_t shape_size = model.initial_shape.size();
+            model.num_levels = static_cast<uint32_t>(reader.readUnsigned());
+
+            std::vector<float> leaf;
+            for (uint32_t level = 0; level < model.num_levels; ++level)
+            {
+                const uint64_t trees = reader.readUnsigned();
+                if (level == 0)
+                    model.trees_per_level = static_cast<uint32_t>(trees);
+                else if (trees != model.trees_per_level)
+                    throw std::runtime_error("cascade levels have different tree counts");
+
+                for (uint64_t tree = 0; tree < trees; ++tree)
+                {
+                    const uint64_t splits = reader.readUnsigned();
+                    if (level == 0 && tree == 0)
+                    {
+                        model.num_splits = static_cast<uint32_t>(splits);
+                        model.num_leaves = model.num_splits + 1;
+                        if ((model.num_leaves & model.num_splits) != 0)
+                            throw std::runtime_error("regression trees are not complete binary trees");
+                        model.splits.reserve(static_cast<size_t>(model.num_levels) * trees * splits);
+                        model.leaves.reserve(static_cast<size_t>(model.num_levels) * trees * model.num_leaves * shape_size);
+                    }
+                    else if (splits != model.num_splits)
+                        throw std::runtime_error("regression trees have different depths");
+
+                    for (uint64_t i = 0; i < splits; ++i)
+                    {
+                        const uint64_t idx1 = reader.readUnsigned();
+                        const uint64_t idx2 = reader.readUnsigned();
+                        if (idx1 > std::numeric_limits<uint16_t>::max() || idx2 > std::numeric_limits<uint16_t>::max())
+                            throw std::runtime_error("feature index out of range");
+                        FlatSplit split;
+                        split.idx1 = static_cast<uint16_t>(idx1);
+                        split.idx2 = static_cast<uint16_t>(idx2);
+                        split.thresh = reader.readFloat();
+                        model.splits.push_back(split);
+                    }
+
+                    if (reader.readUnsigned() != model.num_leaves)
+                        throw std::runtime_error("leaf count does not match split count");
+                    for (uint32_t i = 0; i < model.num_leaves; ++i)
+                    {
+                        reader.readColumnVector(leaf);
+                        if (leaf.size() != shape_size)
+                            throw std::runtime_error("leaf size does not match the shape size");
+                        model.leaves.insert(model.leaves.end(), leaf.begin(), leaf.end());
+                    }
+                }
+            }
+        }
+
+        void parseFeatures(DatReader &reader, ParsedModel &model)
+        {
+            if (reader.readUnsigned() != model.num_levels)
+                throw std::runtime_error("anchor table does not match the cascade");
+            for (uint32_t level = 0; level < model.num_levels; ++level)
+            {
+                const uint64_t count = reader.readUnsigned();
+                if (level == 0)
+                    model.features_per_level = static_cast<uint32_t>(count);
+                else if (count != model.features_per_level)
+                    throw std::runtime_error("cascade levels sample different feature counts");
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const uint64_t anchor = reader.readUnsigned();
+                    if (anchor >= model.initial_shape.size() / 2)
+                        throw std::runtime_error("feature anchor out of range");
+                    model.anchors.push_back(static_cast<uint32_t>(anchor));
+                }
+            }
+
+            if (reader.readUnsigned() != model.num_levels)
+                throw std::runtime_error("delta table does not match the cascade");
+            std::vector<float> xs, ys;
+            for (uint32_t level = 0; level < model.num_levels; ++level)
+            {
+                if (reader.readUnsigned() != model.features_per_level)
+                    throw std::runtime_error("delta count does not match the anchor count");
+                xs.clear();
+                ys.clear();
+                for (uint32_t i = 0; i < model.features_per_level; ++i)
+                {
+                    xs.push_back(reader.readFloat());
+                    ys.push_back(reader.readFloat());
+                }
+                model.deltas.insert(model.deltas.end(), xs.begin(), xs.end());
+                model.deltas.insert(model.deltas.end(), ys.begin(), ys.end());
+            }
+
+            for (const auto &split : model.splits)
+            {
+                if (split.idx1 >= model.features_per_level || split.idx2 >= model.features_per_level)
+                    throw std::runtime_error("split references a missing feature");
+            }
+        }
+
+        uint64_t alignTo16(uint64_t offset)
+        {
+            return (offset + 15) & ~static_cast<uint64_t>(15);
+        }
+
+        template <typename T>
+        void copyArray(std::vector<uint64_t> &storage, uint64_t offset, const std::vector<T> &values)
+        {
+            if (!values.empty())
+                std::memcpy(reinterpret_cast<unsigned char *>(storage.data()) + offset, values.data(), values.size() * sizeof(T));
+        }
+
+        // Size and write time of the source .dat, recorded in the header to spot a stale .flat
+        bool sourceStamp(const std::string &path, uint64_t &size, int64_t &mtime)
+        {
+            std::error_code ec;
+            const uintmax_t file_size = std::filesystem::file_size(path, ec);
+            if (ec)
+                return false;
+            const auto write_time = std::filesystem::last_write_time(path, ec);
+            if (ec)
+                return false;
+            size = static_cast<uint64_t>(file_size);
+            mtime = static_cast<int64_t>(write_time.time_since_epoch().count());
+            return true;
+        }
+
+        std::vector<uint64_t> buildBlob(const ParsedModel &model, const std::string &source_path)
+        {
+            FlatShapeModelHeader header{};
+            std::memcpy(header.magic, FlatShapePredictor::MAGIC, sizeof(header.magic));
+            header.version = FlatShapePredictor::VERSION;
+            header.num_parts = static_cast<uint32_t>(model.initial_shape.size() / 2);
+            header.num_levels = model.num_levels;
+            header.trees_per_level = model.trees_per_level;
+            header.tree_depth = 0;
+            while ((1u << header.tree_depth) < model.num_leaves)
+                header.tree_depth++;
+            header.features_per_level = model.features_per_level;
+            sourceStamp(source_path, header.source_size, header.source_mtime);
+
+            header.initial_shape_offset = alignTo16(sizeof(FlatShapeModelHeader));
+            header.anchors_offset = alignTo16(header.initial_shape_offset + model.initial_shape.size() * sizeof(float));
+            header.deltas_offset = alignTo16(header.anchors_offset + model.anchors.size() * sizeof(uint32_t));
+            header.splits_offset = alignTo16(header.deltas_offset + model.deltas.size() * sizeof(float));
+            header.leaves_offset = alignTo16(header.splits_offset + model.splits.size() * sizeof(FlatSplit));
+            header.total_size = alignTo16(header.leaves_offset + model.leaves.size() * sizeof(float));
+
+            std::vector<uint64_t> storage(header.total_size / sizeof(uint64_t), 0);
+            std::memcpy(storage.data(), &header, sizeof(header));
+            copyArray(storage, header.initial_shape_offset, model.initial_shape);
+            copyArray(storage, header.anchors_offset, model.anchors);
+            copyArray(storage, header.deltas_offset, model.deltas);
+            copyArray(storage, header.splits_offset, model.splits);
+            copyArray(storage, header.leaves_offset, model.leaves);
+            return storage;
+        }
+
+        // Read-only mapping of a whole file; the returned pointer unmaps when released
+        std::shared_ptr<const void> mapFile(const std::string &path, size_t &size)
+        {
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return nullptr;
+            LARGE_INTEGER file_size;
+            HANDLE mapping = nullptr;
+            if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+                mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file);
+            if (!mapping)
+                return nullptr;
+            void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (!view)
+                return nullptr;
+            size = static_cast<size_t>(file_size.QuadPart);
+            return std::shared_ptr<const void>(view, [](const void *p)
+                                               { UnmapViewOfFile(p); });
+#else
+            const int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                return nullptr;
+            struct stat info;
+            void *view = MAP_FAILED;
+            if (fstat(fd, &info) == 0 && info.st_size > 0)
+                view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (view == MAP_FAILED)
+                return nullptr;
+            const size_t length = static_cast<size_t>(info.st_size);
+            size = length;
+            return std::shared_ptr<const void>(view, [length](const void *p)
+                                               { munmap(const_cast<void *>(p), length); });
+#endif
+        }
+    }
+
+    std::shared_ptr<const FlatShapePredictor> FlatShapePredictor::loadDat(const std::string &model_path)
+    {
+        try
+        {
+            std::ifstream file(model_path, std::ios::binary);
+            if (!file)
+                throw std::runtime_error("cannot open " + model_path);
+            const std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            DatReader reader(data.data(), data.size());
+            if (reader.readSigned() != 1)
+                throw std::runtime_error("unsupported shape_predictor version");
+
+            ParsedModel model;
+            reader.readColumnVector(model.initial_shape);
+            if (model.initial_shape.empty() || model.initial_shape.size() % 2 != 0)
+                throw std::runtime_error("invalid initial shape");
+            parseForests(reader, model);
+            parseFeatures(reader, model);
+
+            auto predictor = std::shared_ptr<FlatShapePredictor>(new FlatShapePredictor());
+            predictor->storage_ = buildBlob(model, model_path);
+            std::string error;
+            if (!predictor->attach(reinterpret_cast<const unsigned char *>(predictor->storage_.data()),
+                                   predictor->storage_.size() * sizeof(uint64_t), error))
+                throw std::runtime_error(error);
+            return predictor;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to load shape predictor: " << e.what() << std::endl;
+            return nullptr;
+        }
+    }
+
+    std::shared_ptr<const FlatShapePredictor> FlatShapePredictor::loadFlat(const std::string &flat_path,
+                                                                            const std::string &source_path)
+    {
+        size_t size = 0;
+        std::shared_ptr<const void> mapping = mapFile(flat_path, size);
+        if (!mapping)
+        {
+            std::cerr << "Failed to map flat shape predictor: " << flat_path << std::endl;
+            return nullptr;
+        }
+
+        auto predictor = std::shared_ptr<FlatShapePredictor>(new FlatShapePredictor());
+        std::string error;
+        if (!predictor->attach(static_cast<const unsigned char *>(mapping.get()), size, error))
+        {
+            std::cerr << "Invalid flat shape predictor " << flat_path << ": " << error
+                      << " (re-run convert_shape_predictor)" << std::endl;
+            return nullptr;
+        }
+
+        // A .dat replaced after conversion would otherwise keep running the old model
+        uint64_t source_size = 0;
+        int64_t source_mtime = 0;
+        if (!source_path.empty() && sourceStamp(source_path, source_size, source_mtime) &&
+            (source_size != predictor->header_->source_size || source_mtime != predictor->header_->source_mtime))
+        {
+            std::cerr << "Flat shape predictor " << flat_path << " was not converted from the current " << source_path
+                      << " (re-run convert_shape_predictor)" << std::endl;
+            return nullptr;
+        }
+        predictor->mapping_ = std::move(mapping);
+        return predictor;
+    }
+
+    bool FlatShapePredictor::saveFlat(const std::string &flat_path) const
+    {
+        std::ofstream file(flat_path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << flat_path << " for writing" << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(header_), static_cast<std::streamsize>(header_->total_size));
+        return static_cast<bool>(file);
+    }
+
+    bool FlatShapePredictor::attach(const unsigned char *blob, size_t size, std::string &error)
+    {
+        const auto reject = [&error](const char *reason)
+        {
+            error = reason;
+            return false;
+        };
+
+        if (size < sizeof(FlatShapeModelHeader))
+            return reject("file is shorter than the header");
+
+        const auto *header = reinterpret_cast<const FlatShapeModelHeader *>(blob);
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION)
+            return reject("not a flat shape predictor of this version");
+        if (header->total_size > size)
+            return reject("file is truncated");
+        if (header->num_parts != static_cast<uint32_t>(LandmarkLayout::POINTS))
+        {
+            error = "model has " + std::to_string(header->num_parts) + " landmarks, this build expects " +
+                    std::to_string(LandmarkLayout::POINTS);
+            return false;
+        }
+        // Split indices are 16-bit, which also bounds the feature count; the other limits keep the
+        // size arithmetic below far from overflow
+        if (header->tree_depth == 0 || header->tree_depth > 16 || header->num_levels == 0 || header->num_levels > 1024 ||
+            header->trees_per_level == 0 || header->trees_per_level > 65536 ||
+            header->features_per_level == 0 || header->features_per_level > 65536)
+            return reject("cascade dimensions out of range");
+
+        const uint64_t shape_size = 2ull * header->num_parts;
+        const uint64_t features = static_cast<uint64_t>(header->num_levels) * header->features_per_level;
+        const uint64_t trees = static_cast<uint64_t>(header->num_levels) * header->trees_per_level;
+        const uint64_t leaves = 1ull << header->tree_depth;
+
+        // Every array must lie inside the blob
+        const auto fits = [header](uint64_t offset, uint64_t bytes)
+        {
+            return offset % 4 == 0 && offset <= header->total_size && bytes <= header->total_size - offset;
+        };
+        if (!fits(header->initial_shape_offset, shape_size * sizeof(float)) ||
+            !fits(header->anchors_offset, features * sizeof(uint32_t)) ||
+            !fits(header->deltas_offset, 2 * features * sizeof(float)) ||
+            !fits(header->splits_offset, trees * (leaves - 1) * sizeof(FlatSplit)) ||
+            !fits(header->leaves_offset, trees * leaves * shape_size * sizeof(float)))
+            return reject("an array lies outside the file");
+
+        // Same index checks parseFeatures applies to a .dat, once at load
+        const auto *anchors = reinterpret_cast<const uint32_t *>(blob + header->anchors_offset);
+        for (uint64_t i = 0; i < features; ++i)
+        {
+            if (anchors[i] >= header->num_parts)
+                return reject("feature anchor out of range");
+        }
+        const auto *splits = reinterpret_cast<const FlatSplit *>(blob + header->splits_offset);
+        for (uint64_t i = 0; i < trees * (leaves - 1); ++i)
+        {
+            if (splits[i].idx1 >= header->features_per_level || splits[i].idx2 >= header->features_per_level)
+                return reject("split references a missing feature");
+        }
+
+        header_ = header;
+        initial_shape_ = reinterpret_cast<const float *>(blob + header->initial_shape_offset);
+        anchors_ = reinterpret_cast<const uint32_t *>(blob + header->anchors_offset);
+        deltas_ = reinterpret_cast<const float *>(blob + header->deltas_offset);
+        splits_ = reinterpret_cast<const FlatSplit *>(blob + header->splits_offset);
+        leaves_ = reinterpret_cast<const float *>(blob + header->leaves_offset);
+        return true;
+    }
+
+    void FlatShapePredictor::sampleFeatures(const cv::Mat &frame, const dlib::rectangle &face, size_t level,
+                                            const float *shape, float *features) const
+    {
+        const size_t num_parts = header_->num_parts;
+        const size_t count = header_->features_per_level;
+
+        // Similarity transform from the mean shape to the current estimate, as
+        // dlib's find_tform_between_shapes computes it; only its 2x2 part is used
+        thread_local std::vector<dlib::vector<float, 2>> from_points, to_points;
+        from_points.resize(num_parts);
+        to_points.resize(num_parts);
+        for (size_t i = 0; i < num_parts; ++i)
+        {
+            from_points[i] = dlib::vector<float, 2>(initial_shape_[2 * i], initial_shape_[2 * i + 1]);
+            to_points[i] = dlib::vector<float, 2>(shape[2 * i], shape[2 * i + 1]);
+        }
+        const dlib::matrix<float, 2, 2> tform = dlib::matrix_cast<float>(dlib::find_similarity_transform(from_points, to_points).get_m());
+        const float t00 = tform(0, 0), t01 = tform(0, 1), t10 = tform(1, 0), t11 = tform(1, 1);
+
+        const dlib::point_transform_affine to_image = dlib::impl::unnormalizing_tform(face);
+        const double m00 = to_image.get_m()(0, 0), m01 = to_image.get_m()(0, 1);
+        const double m10 = to_image.get_m()(1, 0), m11 = to_image.get_m()(1, 1);
+        const double b0 = to_image.get_b().x(), b1 = to_image.get_b().y();
+
+        const uint32_t *anchors = anchors_ + level * count;
+        const float *dx = deltas_ + level * 2 * count;
+        const float *dy = dx + count;
+
+        // Pass 1: pixel coordinates for every feature, branch-free so it vectorizes
+        thread_local std::vector<long> xs, ys;
+        xs.resize(count);
+        ys.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float sx = (t00 * dx[i] + t01 * dy[i]) + shape[2 * anchors[i]];
+            const float sy = (t10 * dx[i] + t11 * dy[i]) + shape[2 * anchors[i] + 1];
+            const double ix = m00 * static_cast<double>(sx) + m01 * static_cast<double>(sy) + b0;
+            const double iy = m10 * static_cast<double>(sx) + m11 * static_cast<double>(sy) + b1;
+            xs[i] = static_cast<long>(std::floor(ix + 0.5));
+            ys[i] = static_cast<long>(std::floor(iy + 0.5));
+        }
+
+        // Pass 2: gather intensities; pixels outside the frame read as 0
+        const long cols = frame.cols, rows = frame.rows;
+        const bool bgr = frame.channels() == 3;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (xs[i] < 0 || ys[i] < 0 || xs[i] >= cols || ys[i] >= rows)
+            {
+                features[i] = 0;
+                continue;
+            }
+            const unsigned char *row = frame.ptr<unsigned char>(static_cast<int>(ys[i]));
+            if (bgr)
+            {
+                const unsigned char *pixel = row + 3 * xs[i];
+                features[i] = static_cast<unsigned char>((static_cast<unsigned>(pixel[0]) + pixel[1] + pixel[2]) / 3);
+            }
+            else
+            {
+                features[i] = row[xs[i]];
+            }
+        }
+    }
+
+    void FlatShapePredictor::predict(const cv::Mat &frame, const dlib::rectangle &face, FaceLandmarks &landmarks) const
+    {
+        thread_local std::vector<float> shape;
+        shape.assign(initial_shape_, initial_shape_ + 2 * header_->num_parts);
+        runCascade(frame, face, shape, 0, landmarks);
+    }
+
+    void FlatShapePredictor::predictFrom(const cv::Mat &frame, const dlib::rectangle &face, const FaceLandmarks &start,
+                                         size_t levels, FaceLandmarks &landmarks) const
+    {
+        if (static_cast<size_t>(start.count) != header_->num_parts || levels >= header_->num_levels)
+        {
+            predict(frame, face, landmarks);
+            return;
+        }
+
+        // Starting landmarks in the face box's normalized space, where the cascade works
+        const dlib::point_transform_affine to_normalized = dlib::impl::normalizing_tform(face);
+        thread_local std::vector<float> shape;
+        shape.resize(2 * header_->num_parts);
+        for (size_t i = 0; i < header_->num_parts; ++i)
+        {
+            const dlib::vector<double, 2> p = to_normalized(start.dlibPoint(static_cast<int>(i)));
+            shape[2 * i] = static_cast<float>(p.x());
+            shape[2 * i + 1] = static_cast<float>(p.y());
+        }
+        runCascade(frame, face, shape, header_->num_levels - levels, landmarks);
+    }
+
+    void FlatShapePredictor::runCascade(const cv::Mat &frame, const dlib::rectangle &face, std::vector<float> &shape,
+                                        size_t first_level, FaceLandmarks &landmarks) const
+    {
+        const size_t shape_size = 2 * header_->num_parts;
+        const size_t trees = header_->trees_per_level;
+        const size_t num_leaves = size_t(1) << header_->tree_depth;
+        const size_t num_splits = num_leaves - 1;
+
+        thread_local std::vector<float> features;
+        features.resize(header_->features_per_level);
+
+        for (size_t level = first_level; level < header_->num_levels; ++level)
+        {
+            sampleFeatures(frame, face, level, shape.data(), features.data());
+
+            const FlatSplit *level_splits = splits_ + level * trees * num_splits;
+            const float *level_leaves = leaves_ + level * trees * num_leaves * shape_size;
+            for (size_t tree = 0; tree < trees; ++tree)
+            {
+                // Complete tree in breadth-first order: children of node i are 2i+1 (left) and 2i+2
+                const FlatSplit *splits = level_splits + tree * num_splits;
+                size_t node = 0;
+                while (node < num_splits)
+                {
+                    const FlatSplit &split = splits[node];
+                    node = (features[split.idx1] - features[split.idx2] > split.thresh) ? 2 * node + 1 : 2 * node + 2;
+                }
+
+                const float *leaf = level_leaves + (tree * num_leaves + (node - num_splits)) * shape_size;
+                for (size_t j = 0; j < shape_size; ++j)
+                    shape[j] += leaf[j];
+            }
+        }
+
+        // Same mapping and rounding as dlib's final conversion to a full_object_detection;
+        // attach() guarantees num_parts == FaceLandmarks::MAX_POINTS
+        const dlib::point_transform_affine to_image = dlib::impl::unnormalizing_tform(face);
+        for (size_t i = 0; i < header_->num_parts; ++i)
+        {
+            const dlib::point p = to_image(dlib::vector<float, 2>(shape[2 * i], shape[2 * i + 1]));
+            landmarks.x[i] = static_cast<float>(p.x());
+            landmarks.y[i] = static_cast<float>(p.y());
+        }
+        landmarks.count = static_cast<int>(header_->num_parts);
+    }
+}
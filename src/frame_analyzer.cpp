@@ -0,0 +1,139 @@
+#include "../include/frame_analyzer.h"
+#include "../include/cv_utils.h"
+#include "../include/face_ratio_kernel.h"
+
+namespace DrowsinessDetector
+{
+    FrameAnalyzer::FrameAnalyzer(const Config &config)
+    {
+        this->config_ = config;
+        this->detector_ = std::make_unique<FacialLandmarkDetector>(config);
+        this->state_tracker_ = std::make_unique<StateTracker>();
+        config.enable_head_pose_detection ? this->head_pose_detector_ = std::make_unique<HeadPoseDetector>() : this->head_pose_detector_ = nullptr;
+    }
+
+    bool FrameAnalyzer::initialize()
+    {
+        return initialize(LandmarkPredictor::load(config_));
+    }
+
+    bool FrameAnalyzer::initialize(std::shared_ptr<const LandmarkPredictor> landmark_predictor)
+    {
+        bool detector_ok = detector_->initialize(std::move(landmark_predictor));
+        if (!config_.enable_head_pose_detection)
+            return detector_ok;
+
+        bool head_pose_ok = head_pose_detector_->initialize(640, 480);
+
+        head_pose_detector_->setThresholds(
+            config_.head_pose_yaw_left_threshold,
+            config_.head_pose_yaw_right_threshold,
+            config_.head_pose_pitch_up_threshold,
+            config_.head_pose_pitch_down_threshold);
+
+        return detector_ok && head_pose_ok;
+    }
+
+    bool FrameAnalyzer::isHeadPoseActive() const
+    {
+        return config_.enable_head_pose_detection && head_pose_detector_ && head_pose_detector_->isInitialized();
+    }
+
+    FrameResult FrameAnalyzer::analyze(const cv::Mat &frame, double timestamp_ms, const FrameDeadline *deadline)
+    {
+        FrameResult result;
+        result.timestamp_ms = timestamp_ms;
+        if (deadline)
+            result.processing_start = deadline->start();
+
+        // Detect face and landmarks; EAR, MAR and head pose all read result.landmarks in place
+        result.face_detected = detector_->detectFaceAndLandmarks(frame, result.face_rect, result.landmarks);
+        if (!result.face_detected)
+        {
+            have_last_head_pose_ = false;
+            return result;
+        }
+
+        // Both EARs and the MAR in one pass
+        const FaceRatios ratios = FaceRatioKernel::compute(result.landmarks);
+        result.ear = ratios.ear();
+        result.mar = ratios.mar;
+
+        if (use_event_time_)
+            state_tracker_->setFrameTimestamp(timestamp_ms);
+
+        if (isHeadPoseActive())
+        {
+            // Over budget: keep the previous pose so the distraction timer is not reset, but only for a
+            // few frames; under sustained overload a stale pose would keep DISTRACTED running (or never set it)
+            if (deadline && deadline->expired() && have_last_head_pose_ &&
+                pose_reuse_count_ < config_.max_pose_reuse_frames)
+            {
+                result.head_pose = last_head_pose_;
+                result.pose_skipped = true;
+                pose_reuse_count_++;
+            }
+            else
+            {
+                result.head_pose = head_pose_detector_->estimatePose(result.landmarks, frame.cols, frame.rows);
+                last_head_pose_ = result.head_pose;
+                have_last_head_pose_ = true;
+                pose_reuse_count_ = 0;
+            }
+            result.state = state_tracker_->updateState(result.ear, result.mar, result.head_pose, config_);
+        }
+        else
+        {
+            result.state = state_tracker_->updateState(result.ear, result.mar, config_);
+        }
+
+        result.eyes_closed_duration = state_tracker_->getEyesClosedDuration();
+        result.distraction_duration = state_tracker_->getDistractionDuration();
+        result.timers_active = state_tracker_->isEyesClosedTimerActive() || state_tracker_->isDistractionTimerActive();
+        if (config_.enable_perclos)
+            result.perclos = state_tracker_->getPerclos();
+        if (config_.enable_blink_detection)
+        {
+            result.blink_ended = state_tracker_->didBlinkEnd();
+            if (result.blink_ended)
+                result.blink_duration = state_tracker_->getLastBlink().duration_seconds;
+            result.blink_stats = state_tracker_->getBlinkStats();
+        }
+        return result;
+    }
+
+    bool FrameAnalyzer::shouldLog(const FrameResult &result)
+    {
+        return !result.face_detected || result.state != DriverState::ALERT || result.blink_ended;
+    }
+
+    std::string FrameAnalyzer::generateLogMessage(const FrameResult &result)
+    {
+        if (!result.face_detected)
+            return generateStateMessage(DriverState::NO_FACE_DETECTED);
+        if (result.state == DriverState::ALERT && result.blink_ended)
+            return "Driver blinked";
+        return generateStateMessage(result.state);
+    }
+
+    std::string FrameAnalyzer::generateStateMessage(DriverState state)
+    {
+        switch (state)
+        {
+        case DriverState::DROWSY:
+            return "Driver showing signs of drowsiness";
+        case DriverState::YAWNING:
+            return "Driver is yawning";
+        case DriverState::DROWSY_YAWNING:
+            return "Driver is drowsy and yawning - HIGH RISK";
+        case DriverState::DISTRACTED:
+            return "Driver is looking away from the road";
+        case DriverState::DROWSY_DISTRACTED:
+            return "Driver is drowsy and distracted - CRITICAL RISK";
+        case DriverState::NO_FACE_DETECTED:
+            return "No face detected";
+        default:
+            return "State change detected";
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include "../include/haar_face_detector.h"
+#include <iostream>
+
+namespace DrowsinessDetector
+{
+    HaarFaceDetector::HaarFaceDetector(const Config &config)
+    {
+        scale_factor_ = config.haar_scale_factor;
+        min_neighbors_ = config.haar_min_neighbors;
+        min_face_size_ = config.hog_min_face_size;
+        calibration_ = config.haar_box_calibration;
+    }
+
+    bool HaarFaceDetector::initialize(const std::string &cascade_path)
+    {
+        if (!cascade_.load(cascade_path))
+        {
+            std::cerr << "Failed to load Haar cascade: " << cascade_path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<dlib::rectangle> HaarFaceDetector::detect(const cv::Mat &image)
+    {
+        if (image.empty() || cascade_.empty())
+            return {};
+
+        if (image.channels() == 3)
+            cv::cvtColor(image, gray_buffer_, cv::COLOR_BGR2GRAY);
+        else
+            gray_buffer_ = image;
+
+        cascade_.detectMultiScale(gray_buffer_, faces_buffer_, scale_factor_, min_neighbors_, 0,
+                                  cv::Size(min_face_size_, min_face_size_));
+
+        std::vector<dlib::rectangle> faces;
+        faces.reserve(faces_buffer_.size());
+        for (const auto &face : faces_buffer_)
+            faces.push_back(toHogGeometry(face.x, face.y, face.width, face.height, calibration_));
+        return faces;
+    }
+}
@@ -38,6 +38,8 @@ namespace DrowsinessDetector
         model_points_.push_back(cv::Point3f(225.0f, 170.0f, -135.0f));   // Right eye right corner (landmark 45)
         model_points_.push_back(cv::Point3f(-150.0f, -150.0f, -125.0f)); // Left mouth corner (landmark 48)
         model_points_.push_back(cv::Point3f(150.0f, -150.0f, -125.0f));  // Right mouth corner (landmark 54)
+
+        image_points_.reserve(model_points_.size());
     }
 
     void HeadPoseDetector::initializeCameraMatrix(int img_width, int img_height)
@@ -50,12 +52,12 @@ namespace DrowsinessDetector
                           0, 0, 1);
     }
 
-    HeadPose HeadPoseDetector::estimatePose(const dlib::full_object_detection &landmarks,
+    HeadPose HeadPoseDetector::estimatePose(const FaceLandmarks &landmarks,
                                             int img_width, int img_height)
     {
         HeadPose pose;
 
-        if (!is_initialized_ || landmarks.num_parts() != Constants::FACE_LANDMARK_COUNT)
+        if (!is_initialized_ || !landmarks.isComplete())
         {
             return pose; // Returns invalid pose
         }
@@ -63,9 +65,9 @@ namespace DrowsinessDetector
         try
         {
             // Extract 2D points corresponding to our 3D model
-            std::vector<cv::Point2f> image_points = extractHeadPosePoints(landmarks);
+            extractHeadPosePoints(landmarks, image_points_);
 
-            if (image_points.size() != model_points_.size())
+            if (image_points_.size() != model_points_.size())
             {
                 return pose;
             }
@@ -78,7 +80,7 @@ namespace DrowsinessDetector
 
             // Solve PnP to get rotation and translation vectors
             cv::Mat rotation_vector, translation_vector;
-            bool success = cv::solvePnP(model_points_, image_points, camera_matrix_,
+            bool success = cv::solvePnP(model_points_, image_points_, camera_matrix_,
                                         dist_coeffs_, rotation_vector, translation_vector);
 
             if (!success)
@@ -113,30 +115,12 @@ namespace DrowsinessDetector
         }
     }
 
-    std::vector<cv::Point2f> HeadPoseDetector::extractHeadPosePoints(const dlib::full_object_detection &landmarks) const
+    void HeadPoseDetector::extractHeadPosePoints(const FaceLandmarks &landmarks, std::vector<cv::Point2f> &points) const
     {
-        std::vector<cv::Point2f> points;
-
-        // Extract points corresponding to our 3D model
-        // Nose tip (landmark 30)
-        points.emplace_back(landmarks.part(30).x(), landmarks.part(30).y());
-
-        // Chin (landmark 8)
-        points.emplace_back(landmarks.part(8).x(), landmarks.part(8).y());
-
-        // Left eye left corner (landmark 36)
-        points.emplace_back(landmarks.part(36).x(), landmarks.part(36).y());
-
-        // Right eye right corner (landmark 45)
-        points.emplace_back(landmarks.part(45).x(), landmarks.part(45).y());
-
-        // Left mouth corner (landmark 48)
-        points.emplace_back(landmarks.part(48).x(), landmarks.part(48).y());
-
-        // Right mouth corner (landmark 54)
-        points.emplace_back(landmarks.part(54).x(), landmarks.part(54).y());
-
-        return points;
+        // Landmarks matching model_points_, in LandmarkLayout::HEAD_POSE order
+        points.clear();
+        for (int index : LandmarkLayout::HEAD_POSE)
+            points.push_back(landmarks.point(index));
     }
 
     HeadDirection HeadPoseDetector::classifyHeadDirection(double pitch, double yaw) const
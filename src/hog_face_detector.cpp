@@ -0,0 +1,221 @@
+#include "../include/hog_face_detector.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace DrowsinessDetector
+{
+    template <unsigned long N>
+    class HogFaceDetector::PyramidDetector : public HogFaceDetector::Pyramid
+    {
+    public:
+        using scanner_type = dlib::scan_fhog_pyramid<dlib::pyramid_down<N>>;
+        using detector_type = dlib::object_detector<scanner_type>;
+
+        explicit PyramidDetector(detector_type detector) : detector_(std::move(detector)) {}
+
+        std::vector<dlib::rectangle> detect(const cv::Mat &image) override
+        {
+            if (image.channels() == 1)
+                return detector_(dlib::cv_image<unsigned char>(image));
+            return detector_(dlib::cv_image<dlib::bgr_pixel>(image));
+        }
+
+        void detectLevel(const cv::Mat &level, std::vector<dlib::rect_detection> &detections) override
+        {
+            if (level.channels() == 1)
+                detector_(dlib::cv_image<unsigned char>(level), detections);
+            else
+                detector_(dlib::cv_image<dlib::bgr_pixel>(level), detections);
+        }
+
+        std::unique_ptr<Pyramid> makeSingleLevel() const override
+        {
+            return std::make_unique<PyramidDetector<N>>(rebuild(detector_, detector_.get_scanner(), 1));
+        }
+
+        double levelRatio() const override { return static_cast<double>(N - 1) / N; }
+        unsigned long maxLevels() const override { return detector_.get_scanner().get_max_pyramid_levels(); }
+
+        cv::Size minLevelSize() const override
+        {
+            const auto &scanner = detector_.get_scanner();
+            return cv::Size(static_cast<int>(scanner.get_min_pyramid_layer_width()),
+                            static_cast<int>(scanner.get_min_pyramid_layer_height()));
+        }
+
+        const dlib::test_box_overlap &overlapTester() const override { return detector_.get_overlap_tester(); }
+
+        // New detector with this pyramid type, the source's scanner settings and all of its filter weights
+        template <typename SourceDetector, typename SourceScanner>
+        static detector_type rebuild(const SourceDetector &base, const SourceScanner &source, unsigned long max_levels)
+        {
+            // Same window, cell size and padding as the trained model, so its weights stay valid
+            scanner_type scanner;
+            scanner.set_detection_window_size(source.get_detection_window_width(), source.get_detection_window_height());
+            scanner.set_cell_size(source.get_cell_size());
+            scanner.set_padding(source.get_padding());
+            scanner.set_min_pyramid_layer_size(source.get_min_pyramid_layer_width(), source.get_min_pyramid_layer_height());
+            scanner.set_max_pyramid_levels(max_levels);
+
+            std::vector<typename detector_type::feature_vector_type> weights;
+            for (unsigned long i = 0; i < base.num_detectors(); ++i)
+                weights.push_back(base.get_w(i));
+
+            return detector_type(scanner, base.get_overlap_tester(), weights);
+        }
+
+    private:
+        detector_type detector_;
+    };
+
+    template <unsigned long N>
+    std::unique_ptr<HogFaceDetector::Pyramid> HogFaceDetector::makePyramid(const dlib::frontal_face_detector &base,
+                                                                            int max_levels)
+    {
+        const auto &source = base.get_scanner();
+        const unsigned long levels = max_levels > 0 ? static_cast<unsigned long>(max_levels)
+                                                    : source.get_max_pyramid_levels();
+        return std::make_unique<PyramidDetector<N>>(PyramidDetector<N>::rebuild(base, source, levels));
+    }
+
+    HogFaceDetector::HogFaceDetector(const Config &config)
+    {
+        dlib::frontal_face_detector base = dlib::get_frontal_face_detector();
+        window_size_ = static_cast<long>(base.get_scanner().get_detection_window_width());
+        min_face_size_ = config.hog_min_face_size;
+
+        const int max_levels = config.hog_max_pyramid_levels;
+        switch (config.hog_pyramid_downsample)
+        {
+        case 2:
+            pyramid_ = makePyramid<2>(base, max_levels);
+            break;
+        case 3:
+            pyramid_ = makePyramid<3>(base, max_levels);
+            break;
+        case 4:
+            pyramid_ = makePyramid<4>(base, max_levels);
+            break;
+        case 5:
+            pyramid_ = makePyramid<5>(base, max_levels);
+            break;
+        default:
+            if (config.hog_pyramid_downsample != 6)
+                std::cerr << "Unsupported HOG pyramid downsample " << config.hog_pyramid_downsample
+                          << ", using 6" << std::endl;
+            if (max_levels > 0)
+                pyramid_ = makePyramid<6>(base, max_levels);
+            else
+                pyramid_ = std::make_unique<PyramidDetector<6>>(std::move(base));
+            break;
+        }
+
+        if (config.hog_threads != 1)
+            pool_ = std::make_unique<ThreadPool>(static_cast<size_t>(std::max(0, config.hog_threads)));
+    }
+
+    HogFaceDetector::~HogFaceDetector() = default;
+
+    int HogFaceDetector::threadsPerDetector(int hog_threads, size_t detectors)
+    {
+        if (hog_threads == 1 || detectors <= 1)
+            return hog_threads;
+
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        const int share = static_cast<int>(std::max<size_t>(1, cores / detectors));
+        return hog_threads <= 0 ? share : std::min(hog_threads, share);
+    }
+
+    std::vector<dlib::rectangle> HogFaceDetector::detect(const cv::Mat &image)
+    {
+        if (image.empty())
+            return {};
+        if (pool_)
+            return detectParallel(image);
+        return pyramid_->detect(image);
+    }
+
+    std::vector<dlib::rectangle> HogFaceDetector::detectParallel(const cv::Mat &image)
+    {
+        // Same level sizes as dlib's pyramid: each level is levelRatio() of the previous,
+        // down to the scanner's minimum layer size
+        const double ratio = pyramid_->levelRatio();
+        const cv::Size min_size = pyramid_->minLevelSize();
+        std::vector<double> scales;
+        for (double scale = 1.0; scales.size() < pyramid_->maxLevels(); scale *= ratio)
+        {
+            if (image.cols * scale < min_size.width || image.rows * scale < min_size.height)
+                break;
+            scales.push_back(scale);
+        }
+
+        while (level_detectors_.size() < scales.size())
+            level_detectors_.push_back(pyramid_->makeSingleLevel());
+        level_detections_.resize(scales.size());
+
+        // Level 0 is the most expensive, so it is queued first; every task resizes
+        // straight from the source image and writes only its own slot
+        for (size_t level = 0; level < scales.size(); ++level)
+        {
+            pool_->submit([this, &image, &scales, level]
+                          {
+                              cv::Mat scaled;
+                              if (level == 0)
+                                  scaled = image;
+                              else
+                                  cv::resize(image, scaled, cv::Size(), scales[level], scales[level], cv::INTER_AREA);
+
+                              level_detections_[level].clear();
+                              level_detectors_[level]->detectLevel(scaled, level_detections_[level]);
+                          });
+        }
+        pool_->waitIdle();
+
+        // Map every detection back to image coordinates
+        std::vector<dlib::rect_detection> merged;
+        for (size_t level = 0; level < scales.size(); ++level)
+        {
+            const double scale = scales[level];
+            for (dlib::rect_detection detection : level_detections_[level])
+            {
+                detection.rect = dlib::rectangle(static_cast<long>(std::round(detection.rect.left() / scale)),
+                                                 static_cast<long>(std::round(detection.rect.top() / scale)),
+                                                 static_cast<long>(std::round((detection.rect.right() + 1) / scale)) - 1,
+                                                 static_cast<long>(std::round((detection.rect.bottom() + 1) / scale)) - 1);
+                merged.push_back(detection);
+            }
+        }
+
+        // Non-max suppression across levels, exactly as object_detector does within one pyramid
+        std::sort(merged.begin(), merged.end(),
+                  [](const dlib::rect_detection &a, const dlib::rect_detection &b)
+                  {
+                      return a.detection_confidence > b.detection_confidence;
+                  });
+
+        const dlib::test_box_overlap &overlaps = pyramid_->overlapTester();
+        std::vector<dlib::rectangle> faces;
+        for (const auto &detection : merged)
+        {
+            const bool suppressed = std::any_of(faces.begin(), faces.end(),
+                                                [&](const dlib::rectangle &kept)
+                                                {
+                                                    return overlaps(kept, detection.rect);
+                                                });
+            if (!suppressed)
+                faces.push_back(detection.rect);
+        }
+        return faces;
+    }
+
+    double HogFaceDetector::getMinFaceScale() const
+    {
+        // A face of min_face_size_ pixels still fills the window after this downscale,
+        // so the finest pyramid levels never have to be scanned
+        if (min_face_size_ <= window_size_)
+            return 1.0;
+        return static_cast<double>(window_size_) / min_face_size_;
+    }
+}
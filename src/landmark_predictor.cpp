@@ -0,0 +1,53 @@
+#include "../include/landmark_predictor.h"
+#include "../include/dlib_landmark_predictor.h"
+#include "../include/flat_shape_predictor.h"
+#include <filesystem>
+#include <iostream>
+
+namespace DrowsinessDetector
+{
+    namespace
+    {
+        std::shared_ptr<const LandmarkPredictor> loadEngine(const Config &config)
+        {
+            if (config.use_flat_shape_predictor)
+            {
+                // Prefer the precompiled, memory-mapped model; parse the .dat when it is missing, invalid or stale
+                if (!config.flat_model_path.empty() && std::filesystem::exists(config.flat_model_path))
+                {
+                    if (auto predictor = FlatShapePredictor::loadFlat(config.flat_model_path, config.model_path))
+                        return predictor;
+                    std::cerr << "Falling back to parsing " << config.model_path << std::endl;
+                }
+                else
+                {
+                    std::cerr << "No flat model at " << config.flat_model_path << ", parsing " << config.model_path
+                              << " (convert it once with convert_shape_predictor for fast startup)" << std::endl;
+                }
+                return FlatShapePredictor::loadDat(config.model_path);
+            }
+
+            auto predictor = std::make_shared<DlibLandmarkPredictor>();
+            if (!predictor->load(config.model_path))
+                return nullptr;
+            return predictor;
+        }
+    }
+
+    std::shared_ptr<const LandmarkPredictor> LandmarkPredictor::load(const Config &config)
+    {
+        std::shared_ptr<const LandmarkPredictor> predictor = loadEngine(config);
+        if (!predictor)
+            return nullptr;
+
+        // Every frame would otherwise yield incomplete landmarks and report no face
+        if (predictor->getNumParts() != static_cast<size_t>(LandmarkLayout::POINTS))
+        {
+            std::cerr << "Shape model " << config.model_path << " has " << predictor->getNumParts()
+                      << " landmarks, this build expects " << LandmarkLayout::POINTS
+                      << " (see LandmarkLayout in constants.h)" << std::endl;
+            return nullptr;
+        }
+        return predictor;
+    }
+}
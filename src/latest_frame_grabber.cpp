@@ -0,0 +1,93 @@
+#include "../include/latest_frame_grabber.h"
+#include <chrono>
+
+namespace DrowsinessDetector
+{
+    LatestFrameGrabber::LatestFrameGrabber(cv::VideoCapture &capture) : capture_(capture)
+    {
+    }
+
+    LatestFrameGrabber::~LatestFrameGrabber()
+    {
+        stop();
+    }
+
+    void LatestFrameGrabber::start(double pace_fps)
+    {
+        if (grab_thread_.joinable())
+            return;
+
+        pace_fps_ = pace_fps;
+        should_stop_ = false;
+        grab_thread_ = std::thread(&LatestFrameGrabber::grabLoop, this);
+    }
+
+    void LatestFrameGrabber::grabLoop()
+    {
+        using clock = std::chrono::steady_clock;
+        const auto frame_interval = pace_fps_ > 0.0
+                                        ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / pace_fps_))
+                                        : clock::duration::zero();
+        auto next_read = clock::now();
+
+        while (!should_stop_)
+        {
+            if (!capture_.read(back_buffer_) || back_buffer_.empty())
+                break;
+            frames_grabbed_++;
+            double timestamp_ms = capture_.get(cv::CAP_PROP_POS_MSEC);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (has_new_frame_)
+                    frames_dropped_++; // Previous frame was never taken
+                cv::swap(back_buffer_, latest_frame_);
+                latest_timestamp_ms_ = timestamp_ms;
+                has_new_frame_ = true;
+            }
+            frame_ready_.notify_one();
+
+            if (frame_interval > clock::duration::zero())
+            {
+                next_read += frame_interval;
+                std::this_thread::sleep_until(next_read);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            end_of_stream_ = true;
+        }
+        frame_ready_.notify_all();
+    }
+
+    bool LatestFrameGrabber::takeLatest(cv::Mat &frame, double &timestamp_ms)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        frame_ready_.wait(lock, [this]
+                          { return has_new_frame_ || end_of_stream_; });
+        if (!has_new_frame_)
+            return false;
+
+        // Hand the consumer's previous buffer back to the grabber for reuse
+        cv::swap(latest_frame_, frame);
+        timestamp_ms = latest_timestamp_ms_;
+        has_new_frame_ = false;
+        frames_delivered_++;
+        return true;
+    }
+
+    void LatestFrameGrabber::stop()
+    {
+        should_stop_ = true;
+        if (grab_thread_.joinable())
+            grab_thread_.join();
+    }
+
+    void LatestFrameGrabber::getStats(size_t &grabbed, size_t &dropped, size_t &delivered) const
+    {
+        grabbed = frames_grabbed_;
+        dropped = frames_dropped_;
+        delivered = frames_delivered_;
+    }
+}
@@ -66,7 +66,7 @@ namespace DrowsinessDetector
 
     // @@ with head pose enabled
     void Logger::log(DriverState state, const std::string &message, double ear, double mar,
-                     double head_yaw, const cv::Mat &frame)
+                     double head_yaw, const cv::Mat &frame, const LogMetadata &metadata)
     {
         Logger &logger = getInstance();
         if (!logger.is_initialized_)
@@ -75,12 +75,12 @@ namespace DrowsinessDetector
             return;
         }
 
-        logger.logImpl(state, message, ear, mar, head_yaw, frame);
+        logger.logImpl(state, message, ear, mar, head_yaw, frame, metadata);
     }
 
     // @@ without head pose
     void Logger::log(DriverState state, const std::string &message, double ear, double mar,
-                     const cv::Mat &frame)
+                     const cv::Mat &frame, const LogMetadata &metadata)
     {
         Logger &logger = getInstance();
         if (!logger.is_initialized_)
@@ -89,7 +89,7 @@ namespace DrowsinessDetector
             return;
         }
 
-        logger.logImpl(state, message, ear, mar, frame);
+        logger.logImpl(state, message, ear, mar, frame, metadata);
     }
     void Logger::shutdown()
     {
@@ -153,17 +153,18 @@ namespace DrowsinessDetector
 
     // with head pose enabled
     void Logger::logImpl(DriverState state, const std::string &message, double ear, double mar,
-                         double head_yaw, const cv::Mat &frame)
+                         double head_yaw, const cv::Mat &frame, const LogMetadata &metadata)
     {
         std::string image_filename;
         if (config_.save_snapshots && !frame.empty() && (state != DriverState::ALERT))
         {
-            image_filename = saveSnapshot(frame);
+            image_filename = saveSnapshot(frame, metadata.stream_id);
         }
         if (!image_filename.empty())
             images_saved_++;
 
         LogEntry entry(state, message, ear, mar, head_yaw, image_filename);
+        entry.metadata = metadata;
 
         if (config_.enable_console_logging)
             printToConsole(entry);
@@ -184,17 +185,18 @@ namespace DrowsinessDetector
 
     // with head pose disabled
     void Logger::logImpl(DriverState state, const std::string &message, double ear, double mar,
-                         const cv::Mat &frame)
+                         const cv::Mat &frame, const LogMetadata &metadata)
     {
         std::string image_filename;
         if (config_.save_snapshots && !frame.empty() && (state != DriverState::ALERT))
         {
-            image_filename = saveSnapshot(frame);
+            image_filename = saveSnapshot(frame, metadata.stream_id);
         }
         if (!image_filename.empty())
             images_saved_++;
 
         LogEntry entry(state, message, ear, mar, image_filename);
+        entry.metadata = metadata;
 
         if (config_.enable_console_logging)
             printToConsole(entry);
@@ -238,10 +240,11 @@ namespace DrowsinessDetector
         return ss.str();
     }
 
-    std::string Logger::saveSnapshot(const cv::Mat &frame)
+    std::string Logger::saveSnapshot(const cv::Mat &frame, const std::string &stream_id)
     {
-
-        std::string filename = config_.snapshot_path + "drowsy_detected_" + GetCurrentTimeStamp() + ".jpg";
+        // Streams can raise events within the same millisecond, so their id is part of the name
+        std::string prefix = stream_id.empty() ? "drowsy_detected_" : "drowsy_detected_" + stream_id + "_";
+        std::string filename = config_.snapshot_path + prefix + GetCurrentTimeStamp() + ".jpg";
         if (cv::imwrite(filename, frame))
         {
             return filename;
@@ -254,11 +257,18 @@ namespace DrowsinessDetector
     void Logger::printToConsole(const LogEntry &entry)
     {
         std::cout << this->formatLogTimestamp(entry.timestamp)
+                  << (entry.metadata.stream_id.empty() ? "" : " | " + entry.metadata.stream_id)
                   << " | " << stateToString(entry.state)
                   << " | EAR: " << std::fixed << std::setprecision(3) << entry.ear_value
                   << " | MAR: " << std::fixed << std::setprecision(3) << entry.mar_value
-                  << " | HEAD_YAW: " << std::fixed << std::setprecision(1) << entry.head_yaw << "°"
-                  << " | " << entry.message << std::endl;
+                  << " | HEAD_YAW: " << std::fixed << std::setprecision(1) << entry.head_yaw << "°";
+        if (entry.metadata.perclos >= 0.0)
+            std::cout << " | PERCLOS: " << std::fixed << std::setprecision(3) << entry.metadata.perclos;
+        if (entry.metadata.has_blink_stats)
+            std::cout << " | BLINKS: " << std::fixed << std::setprecision(1) << entry.metadata.blink_stats.rate_per_minute << "/min";
+        if (entry.metadata.blink_duration >= 0.0)
+            std::cout << " | BLINK: " << std::fixed << std::setprecision(0) << entry.metadata.blink_duration * 1000.0 << " ms";
+        std::cout << " | " << entry.message << std::endl;
     }
 
     void Logger::processLogQueue()
@@ -327,12 +337,28 @@ namespace DrowsinessDetector
         nlohmann::json log_json;
 
         log_json["timestamp"] = this->formatLogTimestamp(entry.timestamp);
+        if (!entry.metadata.stream_id.empty())
+            log_json["stream"] = entry.metadata.stream_id;
         log_json["state"] = stateToString(entry.state);
         log_json["ear"] = entry.ear_value;
         log_json["mar"] = entry.mar_value;
         if (entry.head_yaw != 0.0)
             log_json["head_yaw"] = entry.head_yaw;
+        if (entry.metadata.perclos >= 0.0)
+            log_json["perclos"] = entry.metadata.perclos;
+        if (entry.metadata.has_blink_stats)
+        {
+            const BlinkStats &blinks = entry.metadata.blink_stats;
+            log_json["blink"] = {{"rate_per_min", blinks.rate_per_minute},
+                                 {"mean_ms", blinks.mean_duration * 1000.0},
+                                 {"p95_ms", blinks.p95_duration * 1000.0},
+                                 {"count", blinks.total_blinks}};
+        }
+        if (entry.metadata.blink_duration >= 0.0)
+            log_json["blink_ms"] = entry.metadata.blink_duration * 1000.0;
         log_json["message"] = entry.message;
+        if (entry.metadata.media_time_ms >= 0.0)
+            log_json["video_time_ms"] = entry.metadata.media_time_ms;
         if (!entry.image_filename.empty())
             log_json["image"] = entry.image_filename;
 
@@ -351,13 +377,29 @@ namespace DrowsinessDetector
         else
         {
             // Plain text log entry        
-            file << log_entry_time_stamp_str
-                 << " | State: " << stateToString(entry.state)
+            file << log_entry_time_stamp_str;
+            if (!entry.metadata.stream_id.empty())
+                file << " | Stream: " << entry.metadata.stream_id;
+            file << " | State: " << stateToString(entry.state)
                  << " | EAR: " << entry.ear_value
                  << " | MAR: " << entry.mar_value
                  << " | HEAD_YAW: " << (entry.head_yaw == 0.0 ? "null" : std::to_string(entry.head_yaw)) << "°"
                  << " | Message: " << entry.message;
 
+            if (entry.metadata.perclos >= 0.0)
+                file << " | PERCLOS: " << entry.metadata.perclos;
+
+            if (entry.metadata.has_blink_stats)
+                file << " | Blinks: " << entry.metadata.blink_stats.rate_per_minute << "/min"
+                     << ", mean " << entry.metadata.blink_stats.mean_duration * 1000.0 << " ms"
+                     << ", p95 " << entry.metadata.blink_stats.p95_duration * 1000.0 << " ms";
+
+            if (entry.metadata.blink_duration >= 0.0)
+                file << " | Blink: " << entry.metadata.blink_duration * 1000.0 << " ms";
+
+            if (entry.metadata.media_time_ms >= 0.0)
+                file << " | Video Time: " << entry.metadata.media_time_ms << " ms";
+
             if (!entry.image_filename.empty())
                 file << " | Image: " << entry.image_filename;
 
@@ -0,0 +1,188 @@
+#include "../include/multi_stream_server.h"
+#include "../include/logger.h"
+#include "../include/cv_utils.h"
+#include "../include/hog_face_detector.h"
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+namespace DrowsinessDetector
+{
+    MultiStreamServer::MultiStreamServer(const Config &config,
+                                         std::shared_ptr<const LandmarkPredictor> landmark_predictor)
+    {
+        this->config_ = config;
+        this->landmark_predictor_ = std::move(landmark_predictor);
+    }
+
+    bool MultiStreamServer::initialize()
+    {
+        if (!landmark_predictor_)
+            return false;
+
+        // Every stream has its own HOG pool; together they share the cores
+        Config analyzer_config = config_;
+        analyzer_config.hog_threads = HogFaceDetector::threadsPerDetector(config_.hog_threads, config_.stream_sources.size());
+
+        for (size_t i = 0; i < config_.stream_sources.size(); ++i)
+        {
+            auto stream = std::make_unique<Stream>();
+            stream->id = "stream_" + std::to_string(i);
+            stream->source = config_.stream_sources[i];
+
+            if (!openStream(*stream))
+            {
+                std::cerr << "MultiStreamServer: Failed to open " << stream->source << ", skipping" << std::endl;
+                continue;
+            }
+
+            stream->analyzer = std::make_unique<FrameAnalyzer>(analyzer_config);
+            if (!stream->analyzer->initialize(landmark_predictor_))
+                return false;
+            stream->analyzer->setUseEventTime(config_.use_video_timestamps && stream->is_file);
+
+            if (config_.enable_adaptive_frame_rate)
+            {
+                stream->rate_controller = std::make_unique<AdaptiveRateController>(config_);
+                stream->rate_controller->setSourceFps(stream->capture.get(cv::CAP_PROP_FPS));
+            }
+
+            streams_.push_back(std::move(stream));
+        }
+
+        // Stream workers and HOG pools come out of one core budget: each worker runs a detector
+        // that may itself use analyzer_config.hog_threads cores (0 = all of them)
+        size_t workers = static_cast<size_t>(std::max(0, config_.stream_worker_threads));
+        if (workers == 0)
+        {
+            const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+            const size_t hog_threads = analyzer_config.hog_threads <= 0 ? cores : static_cast<size_t>(analyzer_config.hog_threads);
+            workers = std::max<size_t>(1, cores / hog_threads);
+        }
+        pool_ = std::make_unique<ThreadPool>(workers);
+        std::cout << "MultiStreamServer: " << streams_.size() << " streams on " << pool_->size() << " workers" << std::endl;
+        return !streams_.empty();
+    }
+
+    bool MultiStreamServer::openStream(Stream &stream)
+    {
+        // A purely numeric source is a camera index, anything else a file path or URL
+        bool is_camera_index = !stream.source.empty() &&
+                               std::all_of(stream.source.begin(), stream.source.end(),
+                                           [](unsigned char c)
+                                           { return std::isdigit(c) != 0; });
+        if (is_camera_index)
+        {
+            stream.capture.open(std::stoi(stream.source));
+        }
+        else
+        {
+            stream.is_file = std::filesystem::exists(stream.source);
+            stream.capture.open(stream.source);
+        }
+        return stream.capture.isOpened();
+    }
+
+    int MultiStreamServer::run(const std::function<bool()> &stop_requested)
+    {
+        active_streams_ = streams_.size();
+        for (auto &stream : streams_)
+        {
+            Stream *target = stream.get();
+            pool_->submit([this, target]
+                          { processNextFrame(*target); });
+        }
+
+        while (active_streams_ > 0)
+        {
+            if (stop_requested())
+            {
+                should_stop_ = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        pool_->waitIdle();
+
+        size_t total_frames = 0;
+        for (const auto &stream : streams_)
+        {
+            std::cout << stream->id << " (" << stream->source << "): " << stream->processed_frames << " frames" << std::endl;
+            total_frames += stream->processed_frames;
+        }
+        std::cout << "Total Processed Frames: " << total_frames
+                  << " | Tasks stolen: " << pool_->tasksStolen() << std::endl;
+        if (config_.frame_budget_ms > 0.0)
+        {
+            std::cout << "Deadline Misses: " << deadline_stats_.deadline_misses << "/" << deadline_stats_.frames
+                      << " frames | Pose skipped: " << deadline_stats_.pose_skipped
+                      << " | Snapshots skipped: " << deadline_stats_.snapshots_skipped << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    void MultiStreamServer::processNextFrame(Stream &stream)
+    {
+        int frame_skip = stream.rate_controller ? stream.rate_controller->getStride() : config_.frame_skip;
+        bool have_frame = !should_stop_ &&
+                          CVUtils::readNextProcessedFrame(stream.capture, stream.frame, stream.frame_count,
+                                                          frame_skip, stream.is_file && config_.seek_on_frame_skip);
+        if (!have_frame)
+        {
+            stream.capture.release();
+            active_streams_--;
+            return;
+        }
+
+        FrameDeadline deadline(config_.frame_budget_ms);
+        FrameResult result = stream.analyzer->analyze(stream.frame, stream.capture.get(cv::CAP_PROP_POS_MSEC), &deadline);
+        if (result.pose_skipped)
+            deadline_stats_.pose_skipped++;
+        if (stream.rate_controller)
+            stream.rate_controller->update(result, deadline.elapsedMs());
+
+        logFrameResult(stream, stream.frame, result, deadline);
+        stream.processed_frames++;
+        deadline_stats_.frames++;
+        if (deadline.expired())
+            deadline_stats_.deadline_misses++;
+
+        // Re-queue on this worker; idle workers steal it if this one falls behind
+        Stream *target = &stream;
+        pool_->submit([this, target]
+                      { processNextFrame(*target); });
+    }
+
+    void MultiStreamServer::logFrameResult(const Stream &stream, const cv::Mat &frame, const FrameResult &result,
+                                           const FrameDeadline &deadline)
+    {
+        if (!FrameAnalyzer::shouldLog(result))
+            return;
+
+        LogMetadata metadata;
+        metadata.stream_id = stream.id;
+        if (stream.is_file)
+            metadata.media_time_ms = result.timestamp_ms;
+        metadata.perclos = result.perclos;
+        metadata.has_blink_stats = config_.enable_blink_detection;
+        metadata.blink_stats = result.blink_stats;
+        if (result.blink_ended)
+            metadata.blink_duration = result.blink_duration;
+
+        // The event itself is always logged; only the snapshot is shed over budget
+        static const cv::Mat no_snapshot;
+        const cv::Mat *snapshot = &frame;
+        if (config_.save_snapshots && deadline.expired())
+        {
+            snapshot = &no_snapshot;
+            deadline_stats_.snapshots_skipped++;
+        }
+
+        DriverState state = result.face_detected ? result.state : DriverState::NO_FACE_DETECTED;
+        std::string message = FrameAnalyzer::generateLogMessage(result);
+        config_.enable_head_pose_detection ? Logger::log(state, message, result.ear, result.mar, result.head_pose.yaw, *snapshot, metadata) : Logger::log(state, message, result.ear, result.mar, *snapshot, metadata);
+    }
+}
@@ -0,0 +1,74 @@
+#include "../include/perclos_window.h"
+#include <algorithm>
+#include <cmath>
+
+namespace DrowsinessDetector
+{
+    PerclosWindow::PerclosWindow(double window_seconds, double frame_rate)
+    {
+        reset(window_seconds, frame_rate);
+    }
+
+    void PerclosWindow::reset(double window_seconds, double frame_rate)
+    {
+        window_us_ = static_cast<int64_t>(std::llround(std::max(0.0, window_seconds) * 1e6));
+
+        // One bucket per expected frame, plus slots for the partially evicted oldest bucket, the open newest one
+        // and the rounding of bucket_us_
+        const double rate = frame_rate > 0.0 ? frame_rate : 30.0;
+        const size_t frames = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::max(0.0, window_seconds) * rate)));
+        bucket_us_ = std::max<int64_t>(1, window_us_ / static_cast<int64_t>(frames));
+        buckets_.assign(frames + 3, Bucket{0, 0});
+        head_ = 0;
+        size_ = 0;
+        total_us_ = 0;
+        closed_us_ = 0;
+    }
+
+    void PerclosWindow::popOldest()
+    {
+        const Bucket &oldest = buckets_[head_];
+        total_us_ -= oldest.duration_us;
+        closed_us_ -= oldest.closed_us;
+        head_ = (head_ + 1) % buckets_.size();
+        size_--;
+    }
+
+    void PerclosWindow::add(double duration_seconds, bool eyes_closed)
+    {
+        if (buckets_.empty())
+            return;
+
+        const int64_t duration_us = std::min(MAX_SAMPLE_US, static_cast<int64_t>(std::llround(std::max(0.0, duration_seconds) * 1e6)));
+
+        // Open a new bucket once the newest one covers a full bucket; faster sources share buckets
+        Bucket *newest = size_ > 0 ? &buckets_[(head_ + size_ - 1) % buckets_.size()] : nullptr;
+        if (!newest || newest->duration_us >= bucket_us_)
+        {
+            // Unreachable while buckets are at least bucket_us_ long; kept as a bound on memory
+            if (size_ == buckets_.size())
+                popOldest();
+
+            newest = &buckets_[(head_ + size_) % buckets_.size()];
+            *newest = Bucket{0, 0};
+            size_++;
+        }
+
+        newest->duration_us += duration_us;
+        total_us_ += duration_us;
+        if (eyes_closed)
+        {
+            newest->closed_us += duration_us;
+            closed_us_ += duration_us;
+        }
+
+        // Drop buckets that fell out of the window, keeping at least a full window covered
+        while (size_ > 1 && total_us_ - buckets_[head_].duration_us >= window_us_)
+            popOldest();
+    }
+
+    double PerclosWindow::getPerclos() const
+    {
+        return total_us_ > 0 ? static_cast<double>(closed_us_) / static_cast<double>(total_us_) : 0.0;
+    }
+}
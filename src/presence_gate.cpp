@@ -0,0 +1,121 @@
+#include "../include/presence_gate.h"
+#include <algorithm>
+#include <iostream>
+
+namespace DrowsinessDetector
+{
+    PresenceGate::PresenceGate(const Config &config)
+    {
+        this->config_ = config;
+    }
+
+    bool PresenceGate::initialize()
+    {
+        if (config_.presence_gate_mode != PresenceGateMode::CASCADE)
+            return true;
+
+        if (!cascade_.load(config_.presence_gate_cascade_path))
+        {
+            std::cerr << "Failed to load presence gate cascade: " << config_.presence_gate_cascade_path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool PresenceGate::check(const cv::Mat &frame, bool face_on_previous_frame)
+    {
+        pending_ = Pending::NONE;
+
+        // While a face is being followed the gate stays out of the way; MOTION only keeps its
+        // reference frame current so the first check after the face is lost compares adjacent frames
+        if (face_on_previous_frame)
+        {
+            if (config_.presence_gate_mode == PresenceGateMode::MOTION)
+            {
+                downscale(frame, previous_small_);
+                has_reference_ = true;
+            }
+            return true;
+        }
+
+        // No adjacent frame to compare with (start, or the face was tracked until now): this
+        // frame only becomes the reference and goes to the detector uncounted
+        if (config_.presence_gate_mode == PresenceGateMode::MOTION && !has_reference_)
+        {
+            downscale(frame, previous_small_);
+            has_reference_ = true;
+            return true;
+        }
+
+        stats_.checks++;
+        if (looksOccupied(frame))
+        {
+            stats_.passed++;
+            pending_ = Pending::PASSED;
+            return true;
+        }
+
+        stats_.rejected++;
+        const size_t interval = static_cast<size_t>(std::max(0, config_.presence_gate_audit_interval));
+        if (interval > 0 && ++rejections_since_audit_ >= interval)
+        {
+            rejections_since_audit_ = 0;
+            stats_.audits++;
+            pending_ = Pending::AUDIT;
+            return true;
+        }
+        return false;
+    }
+
+    void PresenceGate::report(bool face_found)
+    {
+        switch (pending_)
+        {
+        case Pending::PASSED:
+            if (face_found)
+                stats_.hits++;
+            else
+                stats_.false_alarms++;
+            break;
+        case Pending::AUDIT:
+            if (face_found)
+                stats_.audit_misses++;
+            break;
+        case Pending::NONE:
+            break;
+        }
+        pending_ = Pending::NONE;
+    }
+
+    void PresenceGate::downscale(const cv::Mat &frame, cv::Mat &small)
+    {
+        if (frame.channels() == 3)
+            cv::cvtColor(frame, gray_buffer_, cv::COLOR_BGR2GRAY);
+        else
+            gray_buffer_ = frame;
+
+        const double scale = config_.presence_gate_scale;
+        cv::resize(gray_buffer_, small, cv::Size(), scale, scale, cv::INTER_AREA);
+    }
+
+    bool PresenceGate::looksOccupied(const cv::Mat &frame)
+    {
+        downscale(frame, small_buffer_);
+
+        if (config_.presence_gate_mode == PresenceGateMode::CASCADE)
+        {
+            cascade_.detectMultiScale(small_buffer_, faces_buffer_, 1.2, 2);
+            return !faces_buffer_.empty();
+        }
+
+        // MOTION: mean absolute difference to the previous downscaled frame, in grey levels
+        bool occupied = true;
+        if (previous_small_.size() == small_buffer_.size())
+        {
+            cv::absdiff(small_buffer_, previous_small_, diff_buffer_);
+            occupied = cv::mean(diff_buffer_)[0] >= config_.presence_motion_threshold;
+        }
+        cv::swap(small_buffer_, previous_small_);
+        return occupied;
+    }
+}
@@ -0,0 +1,141 @@
+#include "../include/thread_pool.h"
+#include <algorithm>
+
+namespace DrowsinessDetector
+{
+    namespace
+    {
+        // Identifies the pool and slot of the calling worker thread
+        thread_local const ThreadPool *current_pool = nullptr;
+        thread_local size_t current_worker = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t thread_count)
+    {
+        if (thread_count == 0)
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+        queues_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i)
+            queues_.push_back(std::make_unique<WorkerQueue>());
+
+        workers_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i)
+            workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            should_stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &worker : workers_)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+    }
+
+    int ThreadPool::currentWorkerIndex() const
+    {
+        return current_pool == this ? static_cast<int>(current_worker) : -1;
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        int worker = currentWorkerIndex();
+        size_t target = worker >= 0 ? static_cast<size_t>(worker) : next_queue_++ % queues_.size();
+
+        // Count and publish under wake_mutex_, so a worker only claims a task that is already in a
+        // deque and waitIdle() cannot see the counters before the task exists
+        {
+            std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+            queued_tasks_++;
+            unfinished_tasks_++;
+            std::lock_guard<std::mutex> queue_lock(queues_[target]->mutex);
+            queues_[target]->tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    bool ThreadPool::popTask(size_t index, std::function<void()> &task)
+    {
+        // Own queue first, newest task first
+        {
+            WorkerQueue &own = *queues_[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        // Steal the oldest task from the other workers
+        for (size_t offset = 1; offset < queues_.size(); ++offset)
+        {
+            WorkerQueue &victim = *queues_[(index + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                tasks_stolen_++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::workerLoop(size_t index)
+    {
+        current_pool = this;
+        current_worker = index;
+
+        while (true)
+        {
+            // Claim one queued task before looking for it
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_.wait(lock, [this]
+                           { return should_stop_ || queued_tasks_ > 0; });
+                if (should_stop_ && queued_tasks_ == 0)
+                    return;
+                queued_tasks_--;
+            }
+
+            // Every claim is backed by a published task that only a claimant can pop, so this finds one;
+            // should it not, hand the claim back and wait again rather than spin
+            std::function<void()> task;
+            if (!popTask(index, task))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(wake_mutex_);
+                    queued_tasks_++;
+                }
+                wake_.notify_one();
+                continue;
+            }
+
+            task();
+
+            bool now_idle = false;
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                now_idle = (--unfinished_tasks_ == 0);
+            }
+            if (now_idle)
+                idle_.notify_all();
+        }
+    }
+
+    void ThreadPool::waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        idle_.wait(lock, [this]
+                   { return unfinished_tasks_ == 0; });
+    }
+}
@@ -0,0 +1,62 @@
+#include "../include/yunet_face_detector.h"
+#include <iostream>
+
+#ifdef DROWSINESS_HAVE_YUNET
+
+namespace DrowsinessDetector
+{
+    YuNetFaceDetector::YuNetFaceDetector(const Config &config)
+    {
+        score_threshold_ = static_cast<float>(config.yunet_score_threshold);
+        calibration_ = config.yunet_box_calibration;
+    }
+
+    bool YuNetFaceDetector::initialize(const std::string &model_path)
+    {
+        try
+        {
+            // The input size is a placeholder; it follows the first frame in detect()
+            detector_ = cv::FaceDetectorYN::create(model_path, "", cv::Size(320, 320), score_threshold_);
+            input_size_ = cv::Size(320, 320);
+            return !detector_.empty();
+        }
+        catch (const cv::Exception &e)
+        {
+            std::cerr << "Failed to load YuNet model: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    std::vector<dlib::rectangle> YuNetFaceDetector::detect(const cv::Mat &image)
+    {
+        if (image.empty() || detector_.empty())
+            return {};
+
+        // YuNet takes a continuous 3-channel image
+        if (image.channels() == 1)
+            cv::cvtColor(image, bgr_buffer_, cv::COLOR_GRAY2BGR);
+        else if (!image.isContinuous())
+            image.copyTo(bgr_buffer_);
+        else
+            bgr_buffer_ = image;
+
+        if (bgr_buffer_.size() != input_size_)
+        {
+            input_size_ = bgr_buffer_.size();
+            detector_->setInputSize(input_size_);
+        }
+        detector_->detect(bgr_buffer_, faces_buffer_);
+
+        // One row per face: x, y, w, h, five landmarks, score
+        std::vector<dlib::rectangle> faces;
+        faces.reserve(faces_buffer_.rows);
+        for (int i = 0; i < faces_buffer_.rows; ++i)
+        {
+            faces.push_back(toHogGeometry(faces_buffer_.at<float>(i, 0), faces_buffer_.at<float>(i, 1),
+                                          faces_buffer_.at<float>(i, 2), faces_buffer_.at<float>(i, 3), calibration_));
+        }
+        return faces;
+    }
+}
+
+#endif // DROWSINESS_HAVE_YUNET
@@ -0,0 +1,39 @@
+// One-time conversion of a dlib .dat shape predictor to the flat, memory-mappable
+// format read by FlatShapePredictor::loadFlat(). The output uses this machine's
+// byte order, so convert on (or for) the target architecture.
+//
+// Usage: convert_shape_predictor [input.dat] [output.flat]
+
+#include "../include/flat_shape_predictor.h"
+#include "../include/config.h"
+#include <chrono>
+#include <iostream>
+
+using namespace DrowsinessDetector;
+
+int main(int argc, char *argv[])
+{
+    const Config defaults;
+    const std::string input = argc > 1 ? argv[1] : defaults.model_path;
+    const std::string output = argc > 2 ? argv[2] : defaults.flat_model_path;
+
+    auto parse_start = std::chrono::steady_clock::now();
+    auto predictor = FlatShapePredictor::loadDat(input);
+    auto parse_end = std::chrono::steady_clock::now();
+    if (!predictor || !predictor->saveFlat(output))
+        return -1;
+
+    // Startup cost of the converted model, for comparison with parsing the .dat
+    auto map_start = std::chrono::steady_clock::now();
+    auto mapped = FlatShapePredictor::loadFlat(output, input);
+    auto map_end = std::chrono::steady_clock::now();
+    if (!mapped)
+        return -1;
+
+    std::cout << "Wrote " << output << " (" << predictor->getModelBytes() / (1024.0 * 1024.0) << " MB, "
+              << predictor->getNumLevels() << " cascade levels)\n"
+              << "Parse .dat: " << std::chrono::duration<double, std::milli>(parse_end - parse_start).count() << " ms\n"
+              << "Map .flat:  " << std::chrono::duration<double, std::milli>(map_end - map_start).count() << " ms"
+              << std::endl;
+    return 0;
+}